@@ -15,7 +15,7 @@ if [ $? -ne 0 ]; then
     echo "[WARN] Given filename to build: $1"
     echo "[WARN] Syntax: bash nubb++build.sh [path-of-file-to-compile]"
 else
-    echo $(g++ -o nubb.out out.cpp)
+    echo $(g++ -std=c++20 -pthread -o nubb.out out.cpp) # threads for PARALLEL FOR
 fi
 
 # delete original cpp file once compilation is done
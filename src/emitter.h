@@ -3,7 +3,29 @@
 
 #include <iostream> // IO
 #include <string>   // for std::string
+#include <string_view> // for std::string_view
 #include <fstream>  // file IO operations
+#include <vector>   // for std::vector
+
+// Spot in the emitted code where the C++ for a Nubb++ source line starts
+struct SourceMapping
+{
+    size_t codePos {};  // Index in Emitter::code, the header is added on when the output is put together
+    int sourceLine {};  // Nubb++ source line, starting at 1
+};
+
+// C++ string literal holding text, for file names and the like in emitted code
+constexpr std::string cppString(std::string_view text)
+{
+    std::string literal { "\"" };
+    for (char c : text)
+    {
+        if (c == '\\' || c == '"')
+            literal += '\\';
+        literal += c;
+    }
+    return literal + "\"";
+}
 
 // Helper struct that works with the Parser to emit code to output file
 struct Emitter
@@ -11,11 +33,52 @@ struct Emitter
     std::string fullPath {}; // Contains filepath to file of outputted C++ code
     std::string header {};   // String containing content to prepend (add at rout) later in output file (like headers and variable declarartions)
     std::string code {};     // String containing all C++ code to be emitted
+    std::ostream* log { &std::cout }; // Where [INFO] messages go, nullptr to stay quiet
+    std::vector<SourceMapping> mappings {}; // Source lines of emitted code, only filled in for source maps
 
-    void emit(std::string_view fragement_code); 
-    void emitLine(std::string_view fragement_code); 
-    void headerLine(std::string_view fragement_code);
-    void writeFile(std::string_view _code, std::string_view _header);
+    constexpr void emit(std::string_view fragement_code); 
+    constexpr void emitLine(std::string_view fragement_code); 
+    constexpr void headerLine(std::string_view fragement_code);
+    constexpr void mapSourceLine(int sourceLine);
+    constexpr void insert(size_t pos, std::string_view fragement_code);
+    bool writeFile(std::string_view text);
 };
 
+// Append fragment of code from Parser to std::string code
+constexpr void Emitter::emit(std::string_view fragement_code) 
+{
+    code += fragement_code; 
+}
+
+// Append fragment of code from Parser with a newline to std::string code
+constexpr void Emitter::emitLine(std::string_view fragement_code) 
+{
+    code += fragement_code;
+    code += '\n';
+}
+
+// Append fragment of code to root of C++ file
+constexpr void Emitter::headerLine(std::string_view fragment_code) 
+{
+    header += fragment_code;
+    header += '\n'; 
+}
+
+// Remember that code emitted from here on comes from sourceLine
+constexpr void Emitter::mapSourceLine(int sourceLine)
+{
+    mappings.push_back(SourceMapping { code.size(), sourceLine });
+}
+
+// Put fragment of code into code at pos, moving source map entries after it along
+constexpr void Emitter::insert(size_t pos, std::string_view fragement_code)
+{
+    code.insert(pos, fragement_code);
+    for (SourceMapping& mapping : mappings)
+    {
+        if (mapping.codePos > pos) // an entry right at pos is the statement the fragment belongs to
+            mapping.codePos += fragement_code.size();
+    }
+}
+
 #endif
@@ -2,8 +2,10 @@
 #define LEXER_H
 
 #include <string> // for std::string 
-#include <cstdlib>  // for std::exit
+#include <string_view> // for std::string_view
 #include <iostream> // IO
+#include <stdexcept> // for std::runtime_error
+#include <vector> // for std::vector
 
 struct TokenType
 {
@@ -38,6 +40,42 @@ struct TokenType
         ENDFUNCTION = 121,
         RETURN = 122,
         CALL = 123,
+        BENCH = 124,
+        ITER = 125,           // Iteration count of a BENCH
+        ENDBENCH = 126,
+        FOREACH = 127,
+        LINE = 128,           // FOREACH LINE loops over the lines of a file
+        IN = 129,
+        ENDFOREACH = 130,
+        WRITE = 131,
+        RESERVE = 132,        // Capacity for an array that ADD will fill
+        WITH = 133,           // Parameters of a FUNCTION, arguments of a CALL
+        MOVE = 134,           // Hand an array or string over instead of copying it
+        CONST = 135,          // Value worked out at compile time
+        PURE = 136,           // FUNCTION that can run at compile time
+        PARALLEL = 137,       // FOR loop split across threads
+        GRAIN = 138,          // Iterations a thread takes at a time in a PARALLEL FOR
+        REDUCE = 139,         // Variables a PARALLEL FOR adds up (or multiplies) across threads
+        SUM = 140,            // Built-ins on whole arrays
+        MIN = 141,
+        MAX = 142,
+        SORT = 143,
+        FIND = 144,
+        INSERT = 145,         // Key and value into a map
+        ERASE = 146,          // Key out of a map
+        CONTAINS = 147,       // Whether a map has a key
+        GENERATOR = 148,      // FUNCTION that YIELDs values one at a time
+        YIELD = 149,
+        EACH = 150,           // FOR EACH loops over an array or the values of a GENERATOR
+        WHERE = 151,          // Stages of a FOR EACH: only some values, worked out from them, only the first n
+        MAP = 152,
+        TAKE = 153,
+        TRANSPOSE = 154,      // Built-ins on matrices
+        MULTIPLY = 155,
+        ROWSUM = 156,
+        COLSUM = 157,
+        ROWS = 158,
+        COLS = 159,
         // Operators.
         EQ = 201,       // Single Equal '=' 
         PLUS = 202,
@@ -70,6 +108,19 @@ struct TokenType
         BOOL_T = 505,
         AUTO_T = 506,
         ARRAY_T = 507,
+        MAP_T = 508,
+        MATRIX_T = 509,
+        // Fixed-width numbers.
+        I8_T = 510,
+        I16_T = 511,
+        I32_T = 512,
+        I64_T = 513,
+        U8_T = 514,
+        U16_T = 515,
+        U32_T = 516,
+        U64_T = 517,
+        F32_T = 518,
+        F64_T = 519,
         // Miscellaneous.
         COLON = 601,
         COMMA = 602,
@@ -82,22 +133,572 @@ struct Token
 {
     std::string tokenText;  // Empty to start
     int tokenKind;          // Unknown enum value to start
+    size_t tokenPos { 0 };  // Index of first character of token in source string
+    int tokenLine { 0 };    // Source line of token, starting at 1, for #line directives and source maps
 };
 
+// Thrown by abort() in the Lexer and Parser so whoever started compilation decides how to report it,
+// worker threads can't just std::exit on the rest of the compiler
+struct CompileError : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// constexpr stand-in for std::to_string(), used for error messages
+constexpr std::string toString(long long value)
+{
+    std::string digits {};
+    bool negative { value < 0 };
+    unsigned long long magnitude { negative ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value) };
+
+    do
+    {
+        digits.insert(digits.begin(), static_cast<char>('0' + magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (negative)
+        digits.insert(digits.begin(), '-');
+    return digits;
+}
+
+// Every member function is constexpr so the front end can also run inside a C++ compiler, see nubb_constexpr.h
 struct Lexer
 {
     std::string source;     // String containing source file contents
     size_t curPos { 0 };    // Current index position in source string 
     char curChar { ' ' } ;  // Current character found in source string
+    int curLine { 1 };      // Source line of curChar, starts above 1 when lexing part of a file
+    std::ostream* log { &std::cout }; // Where [INFO] messages go, nullptr to stay quiet
+
+    static constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+    static constexpr bool isAlnum(char c) { return isDigit(c) || isAlpha(c); }
 
-    void init_source();
-    TokenType::Token isKeywordorType(std::string_view tokText);
-    void nextChar();
-    char peekChar();
+    constexpr void init_source();
+    constexpr TokenType::Token isKeywordorType(std::string_view tokText);
+    constexpr void nextChar();
+    constexpr char peekChar();
     void abort(std::string_view message);
-    void skipWhitespace();
-    void skipComments();
-    Token getToken();
+    constexpr void skipWhitespace();
+    constexpr void skipComments();
+    constexpr Token scanToken();
+    constexpr Token getToken();
+    constexpr Token lookAhead(int count);
+    constexpr std::vector<Token> restOfLine();
 };
 
+// verify if string in source is identifier, keyword, or type
+constexpr TokenType::Token Lexer::isKeywordorType(std::string_view tokText)
+{
+    if (tokText == "LABEL")
+        return TokenType::Token::LABEL;
+    else if (tokText == "GOTO")
+        return TokenType::Token::GOTO;
+    else if (tokText == "PRINT")
+        return TokenType::Token::PRINT;
+    else if (tokText == "INPUT")
+        return TokenType::Token::INPUT;
+    else if (tokText == "LET")
+        return TokenType::Token::LET;
+    else if (tokText == "CAST")
+        return TokenType::Token::CAST;
+    else if (tokText == "IF")
+        return TokenType::Token::IF;
+    else if (tokText == "THEN")
+        return TokenType::Token::THEN;
+    else if (tokText == "ENDIF")
+        return TokenType::Token::ENDIF;
+    else if (tokText == "ELIF")
+        return TokenType::Token::ELIF;
+    else if (tokText == "ELSE")
+        return TokenType::Token::ELSE;
+    else if (tokText == "WHILE")
+        return TokenType::Token::WHILE;
+    else if (tokText == "REPEAT")
+        return TokenType::Token::REPEAT;
+    else if (tokText == "ENDWHILE")
+        return TokenType::Token::ENDWHILE;
+    else if (tokText == "FOR")
+        return TokenType::Token::FOR;
+    else if (tokText == "ENDFOR")
+        return TokenType::Token::ENDFOR;
+    else if (tokText == "ADD")
+        return TokenType::Token::ADD_ARRAY;
+    else if (tokText == "POP")
+        return TokenType::Token::POP_ARRAY;
+    else if (tokText == "FUNCTION")
+        return TokenType::Token::FUNCTION;
+    else if (tokText == "VOID")
+        return TokenType::Token::VOID_SPECIFIER;
+    else if (tokText == "ENDFUNCTION")
+        return TokenType::Token::ENDFUNCTION;
+    else if (tokText == "RETURN")
+        return TokenType::Token::RETURN;
+    else if (tokText == "CALL")
+        return TokenType::Token::CALL;
+    else if (tokText == "BENCH")
+        return TokenType::Token::BENCH;
+    else if (tokText == "ITER")
+        return TokenType::Token::ITER;
+    else if (tokText == "ENDBENCH")
+        return TokenType::Token::ENDBENCH;
+    else if (tokText == "FOREACH")
+        return TokenType::Token::FOREACH;
+    else if (tokText == "LINE")
+        return TokenType::Token::LINE;
+    else if (tokText == "IN")
+        return TokenType::Token::IN;
+    else if (tokText == "ENDFOREACH")
+        return TokenType::Token::ENDFOREACH;
+    else if (tokText == "WRITE")
+        return TokenType::Token::WRITE;
+    else if (tokText == "RESERVE")
+        return TokenType::Token::RESERVE;
+    else if (tokText == "WITH")
+        return TokenType::Token::WITH;
+    else if (tokText == "MOVE")
+        return TokenType::Token::MOVE;
+    else if (tokText == "CONST")
+        return TokenType::Token::CONST;
+    else if (tokText == "PURE")
+        return TokenType::Token::PURE;
+    else if (tokText == "PARALLEL")
+        return TokenType::Token::PARALLEL;
+    else if (tokText == "GRAIN")
+        return TokenType::Token::GRAIN;
+    else if (tokText == "REDUCE")
+        return TokenType::Token::REDUCE;
+    else if (tokText == "SUM")
+        return TokenType::Token::SUM;
+    else if (tokText == "MIN")
+        return TokenType::Token::MIN;
+    else if (tokText == "MAX")
+        return TokenType::Token::MAX;
+    else if (tokText == "SORT")
+        return TokenType::Token::SORT;
+    else if (tokText == "FIND")
+        return TokenType::Token::FIND;
+    else if (tokText == "INSERT")
+        return TokenType::Token::INSERT;
+    else if (tokText == "ERASE")
+        return TokenType::Token::ERASE;
+    else if (tokText == "CONTAINS")
+        return TokenType::Token::CONTAINS;
+    else if (tokText == "GENERATOR")
+        return TokenType::Token::GENERATOR;
+    else if (tokText == "YIELD")
+        return TokenType::Token::YIELD;
+    else if (tokText == "EACH")
+        return TokenType::Token::EACH;
+    else if (tokText == "WHERE")
+        return TokenType::Token::WHERE;
+    else if (tokText == "MAP")
+        return TokenType::Token::MAP;
+    else if (tokText == "TAKE")
+        return TokenType::Token::TAKE;
+    else if (tokText == "TRANSPOSE")
+        return TokenType::Token::TRANSPOSE;
+    else if (tokText == "MULTIPLY")
+        return TokenType::Token::MULTIPLY;
+    else if (tokText == "ROWSUM")
+        return TokenType::Token::ROWSUM;
+    else if (tokText == "COLSUM")
+        return TokenType::Token::COLSUM;
+    else if (tokText == "ROWS")
+        return TokenType::Token::ROWS;
+    else if (tokText == "COLS")
+        return TokenType::Token::COLS;
+    else if (tokText == "OR")
+        return TokenType::Token::OR;
+    else if (tokText == "AND")
+        return TokenType::Token::AND;
+    else if (tokText == "NOT")
+        return TokenType::Token::NOT;
+    else if (tokText == "False")
+        return TokenType::Token::FALSE;
+    else if (tokText == "True")
+        return TokenType::Token::TRUE;
+    else if (tokText == "None")
+        return TokenType::Token::NONE;
+    else if (tokText == "int")
+        return TokenType::Token::INT_T;
+    else if (tokText == "float")
+        return TokenType::Token::FLOAT_T;
+    else if (tokText == "double")
+        return TokenType::Token::DOUBLE_T;
+    else if (tokText == "string")
+        return TokenType::Token::STRING_T;
+    else if (tokText == "bool")
+        return TokenType::Token::BOOL_T;
+    else if (tokText == "auto")
+        return TokenType::Token::AUTO_T;
+    else if (tokText == "array")
+        return TokenType::Token::ARRAY_T;
+    else if (tokText == "map")
+        return TokenType::Token::MAP_T;
+    else if (tokText == "matrix")
+        return TokenType::Token::MATRIX_T;
+    else if (tokText == "i8")
+        return TokenType::Token::I8_T;
+    else if (tokText == "i16")
+        return TokenType::Token::I16_T;
+    else if (tokText == "i32")
+        return TokenType::Token::I32_T;
+    else if (tokText == "i64")
+        return TokenType::Token::I64_T;
+    else if (tokText == "u8")
+        return TokenType::Token::U8_T;
+    else if (tokText == "u16")
+        return TokenType::Token::U16_T;
+    else if (tokText == "u32")
+        return TokenType::Token::U32_T;
+    else if (tokText == "u64")
+        return TokenType::Token::U64_T;
+    else if (tokText == "f32")
+        return TokenType::Token::F32_T;
+    else if (tokText == "f64")
+        return TokenType::Token::F64_T;
+    else
+        return TokenType::Token::IDENT; // no keywords match, return identifier token enum
+}
+
+// append newline to source string to help parse last token, then start searching source
+constexpr void Lexer::init_source()
+{
+    source += '\n';
+    nextChar();
+
+    if (log)
+        *log << "[INFO] LEXER: Source initialized.\n";
+}
+
+// find next character in source, stop search on EOF
+constexpr void Lexer::nextChar()
+{
+    if (curChar == '\n') // leaving a line behind
+        curLine++;
+
+    if ((static_cast<int>(curPos)) >= static_cast<int>(source.length())) // Reached end of source or about to exceed bounds
+    {
+        curChar = '\0'; 
+    }
+    else
+    {
+        curChar = source[curPos];
+        curPos+=1;
+    }
+}
+
+// Peek for next character for multi-chaacter tokens
+constexpr char Lexer::peekChar()
+{
+    if (((static_cast<int>(curPos)) + 1) > static_cast<int>(source.length())) // Reached end of source or about to exceed bounds
+    {
+        return '\0';
+    }
+    return source[curPos]; 
+}
+
+// Stop on fatal error in Lexing process. Not constexpr on purpose, reaching it while the front end runs
+// inside a C++ compiler is what turns a Nubb++ error into a C++ compile error.
+inline void Lexer::abort(std::string_view message)
+{
+    throw CompileError("Lexing error. " + std::string(message));
+}
+
+// Skip whitespace while searching source
+constexpr void Lexer::skipWhitespace()
+{
+    while (curChar == ' ' || curChar == '\t' || curChar == '\r') // All forms of whitespace chars + carriage return
+    {
+        nextChar(); 
+    }
+}
+
+// Skip comments while searching source
+constexpr void Lexer::skipComments()
+{
+    if (curChar == '#')
+    {
+        while (curChar != '\n') // Haven't reached end of comment yet
+        {
+            nextChar();
+        }
+    }
+}
+
+// Retrieve and return tokens in source to parser/user, stamped with where they start in source
+constexpr Token Lexer::getToken()
+{
+    skipWhitespace(); 
+    skipComments(); 
+
+    size_t startPos { curPos - 1 }; // curChar was read from source[curPos - 1]
+    int startLine { curLine };
+    Token token { scanToken() };
+    token.tokenPos = startPos;
+    token.tokenLine = startLine;
+    return token;
+}
+
+// Token count places after the one getToken() returned last, without moving on. For the few spots where the
+// parser needs to see further than peekToken
+constexpr Token Lexer::lookAhead(int count)
+{
+    size_t savedPos { curPos };
+    char savedChar { curChar };
+    int savedLine { curLine };
+
+    Token token {};
+    for (int i { 0 }; i < count; i++)
+    {
+        token = getToken();
+    }
+
+    curPos = savedPos;
+    curChar = savedChar;
+    curLine = savedLine;
+    return token;
+}
+
+// Every token after the one getToken() returned last up to the end of its line, without moving on
+constexpr std::vector<Token> Lexer::restOfLine()
+{
+    size_t savedPos { curPos };
+    char savedChar { curChar };
+    int savedLine { curLine };
+
+    std::vector<Token> tokens {};
+    for (Token token { getToken() }; token.tokenKind != TokenType::Token::NEWLINE && token.tokenKind != TokenType::Token::ENDOFFILE; token = getToken())
+    {
+        tokens.push_back(token);
+    }
+
+    curPos = savedPos;
+    curChar = savedChar;
+    curLine = savedLine;
+    return tokens;
+}
+
+// Lex token starting at curChar, whitespace and comments are already skipped by getToken()
+constexpr Token Lexer::scanToken()
+{
+    auto token = Token {"Unknown Token", TokenType::Token::UNKNOWN}; 
+
+    if (curChar == '+') // PLUS 
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {"+=", TokenType::Token::PLUSEQ};
+            // nextChar runs twice to get to next character, then again to go to next token in source
+            nextChar();
+            return token;
+        }
+        else if (peekChar() == '+')
+        {
+            nextChar();
+            auto token = Token {"++", TokenType::Token::PLUSPLUS};
+            nextChar();
+            return token;
+        }
+        else
+        {
+            auto token = Token {"+", TokenType::Token::PLUS}; 
+            nextChar(); 
+            return token;
+        }
+    }
+    else if (curChar == '-') // MINUS token
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {"-=", TokenType::Token::MINUSEQ};
+            nextChar();
+            return token;
+        }
+        else if (peekChar() == '-')
+        {
+            nextChar();
+            auto token = Token {"--", TokenType::Token::MINUSMINUS};
+            nextChar();
+            return token;
+        }
+        else
+        {
+            auto token = Token {"-", TokenType::Token::MINUS}; 
+            nextChar(); 
+            return token;
+        }
+    }
+    else if (curChar == '/') // SLASH 
+    {
+        auto token = Token {"/", TokenType::Token::SLASH};
+        nextChar(); 
+        return token;
+    }
+    else if (curChar == '*') // ASTERISK 
+    {
+        auto token = Token {"*", TokenType::Token::ASTERISK};
+        nextChar();
+        return token;
+    }
+    else if (curChar == '\n') // NEWLINE 
+    {
+        auto token = Token {"NEWLINE CHARACTER", TokenType::Token::NEWLINE};
+        nextChar(); 
+        return token;
+    }
+    else if (curChar == '=') // =/EQ or ==/EQEQ operators
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {"==", TokenType::Token::EQEQ};
+            nextChar();
+            return token;
+        }
+        else
+        {
+            auto token = Token {"=", TokenType::Token::EQ};
+            nextChar();
+            return token;
+        }
+    }
+    else if (curChar == '>') // >/GT or >=/GTEQ operators
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {">=", TokenType::Token::GTEQ};
+            nextChar();
+            return token;
+        }
+        else
+        {
+            auto token = Token {">", TokenType::Token::GT};
+            nextChar();
+            return token;
+        }
+    }
+    else if (curChar == '<') // </LT or <=/LTEQ operators
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {"<=", TokenType::Token::LTEQ};
+            nextChar();
+            return token;
+        }
+        else
+        {
+            auto token = Token {"<", TokenType::Token::LT};
+            nextChar();
+            return token;
+        }
+    }
+    else if (curChar == '!') // NOTEQ/!= operator
+    {
+        if (peekChar() == '=')
+        {
+            nextChar();
+            auto token = Token {"!=", TokenType::Token::NOTEQ};
+            nextChar();
+            return token;
+        }
+        else // given unexpected logical NOT, not yet supported :(
+        {
+            abort("Expected Token NOTEQ or !=, got: " + toString(peekChar()));
+        }
+    }
+    else if (curChar == '\"') // Parsing strings
+    {
+        size_t startPosStr = curPos; // Mark start of string to later extract
+        nextChar();                  // Check content of string starting from here
+
+        while (curChar != '\"') // Search string until illegal character is found or end of string is reached
+        {
+            if (curChar == '\r' || curChar == '\n' || curChar == '\t' || curChar == '\\' || curChar == '%') // prevent some special characters in string to make C++ compilation easier
+            {
+                abort("Illegal character found in string: " + toString(curChar));
+            }
+            nextChar();
+        }
+        // substr starts from first parameter index then extracts until it reaches (2nd param value) length of characters, not to the index of the second parameter!
+        // 2nd param is to the total length of the string - 1, to discard quotation mark
+        auto token = Token {source.substr(startPosStr, (curPos-startPosStr)-1), TokenType::Token::STRING}; 
+        nextChar();
+        return token;
+    }
+    else if (isDigit(curChar)) // Parse numbers (int/floating-point)
+    {
+        size_t startPosStr = curPos - 1; // Mark start of number(s) to extract
+            
+        while (isDigit(peekChar()))
+        {
+            nextChar();
+        }
+        if (peekChar() == '.') // Decimal point
+        {
+            nextChar();
+
+            if (!(isDigit(peekChar()))) // Non-integral element after decimal point
+            {
+                abort("Illegal character in number: " + toString(curChar));
+            }
+            while ((isDigit(peekChar())))
+            {
+                nextChar();
+            }
+        }
+        // substr starts from first parameter index then extracts until it reaches (2nd param value) length of characters, not to the index of the second parameter!
+        // 2nd param is to the last number found
+        auto token = Token {source.substr(startPosStr, (curPos-startPosStr)), TokenType::Token::NUMBER}; 
+        nextChar(); 
+        return token;
+    }
+    else if (curChar == ':') // COLON
+    {
+        auto token = Token {":", TokenType::Token::COLON};
+        nextChar();
+        return token; 
+    }
+    else if (curChar == ',') // COMMA
+    {
+        auto token = Token {",", TokenType::Token::COMMA};
+        nextChar();
+        return token;
+    }
+    else if (isAlpha(curChar)) // Parsing identifiers or keywords
+    {
+        size_t startPosStr = curPos - 1; // Mark start of character(s) to extract for keyword/identifier
+
+        while (isAlnum(curChar)) // Retrieve all consective alphanumeric characters, until non-alphanumeric character is reached
+        {
+            nextChar();
+        }
+        // Create substring of keyword or identifier, then check if substring is keyword or identifier
+        auto subStrToken = source.substr(startPosStr, (curPos-startPosStr) - 1);
+        auto keyword = Lexer::isKeywordorType(subStrToken);
+
+        // substr starts from first parameter index then extracts until it reaches (2nd param value) length of characters, not to the index of the second parameter!
+        // 2nd param is to the last character in keyword/identifier
+        auto token = Token {subStrToken, keyword}; 
+        return token;
+    }
+    else if (curChar == '\0') // EOF token
+    {
+        auto token = Token {"EOF CHARACTER", TokenType::Token::ENDOFFILE};
+        nextChar(); 
+        return token;
+    }
+    else // Unknown token
+        abort("Unknown token: " + toString(curChar)); 
+
+    return token; // solely here to satisfy g++, will never actually execute since abort() gets called otherwise
+}
+
 #endif
+
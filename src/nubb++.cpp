@@ -4,9 +4,11 @@
 #include <cstdlib>   // std::exit
 #include <fstream>   // file IO operations 
 #include <chrono>    // Compile time of compilation from Nubb++ to C++
+#include <string_view> // command-line arguments
+#include <thread>    // std::thread::hardware_concurrency
+#include <algorithm> // std::max
 
-#include "lexer.h"   // forward-declaration of lexer components
-#include "parser.h"  // forward-declaration of parser component
+#include "nubb.h"    // libnubb, compiles source in memory
 #include "emitter.h" // forward-declaration of emitter component
 
 int main(int argc, char **argv)
@@ -15,14 +17,98 @@ int main(int argc, char **argv)
     std::cout << "[INFO] Nubb++ Compiler 3.2\n";
     auto startCompileTime = std::chrono::high_resolution_clock::now(); // get start time of compilation
 
-    if (argc != 2) // too few arguments, no source file given
+    const char* sourcePath { nullptr }; // path of source file to compile
+    unsigned jobs { 1 };                // worker threads for the front end, 1 parses on the main thread only
+    bool lineDirectives { false };      // point out.cpp back at the Nubb++ source with #line directives
+    bool sourceMap { false };           // write out.cpp.map.json next to out.cpp
+    bool profile { false };             // compiled program writes nubb_profile.txt, see nubb-prof
+    bool trace { false };               // compiled program writes nubb_trace.json for Perfetto
+    bool pgoGenerate { false };         // compiled program writes nubb_pgo.txt for --pgo-use
+    const char* pgoPath { nullptr };    // nubb_pgo.txt to optimise with
+    bool allocProfile { false };        // compiled program writes nubb_alloc.txt
+    nubb::Options::Bounds bounds { nubb::Options::Bounds::OFF }; // array index checking
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        std::string_view arg { argv[i] };
+
+        if (arg == "-j" && i + 1 < argc) // -j N
+        {
+            jobs = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg.starts_with("--jobs=")) // --jobs=N
+        {
+            jobs = static_cast<unsigned>(std::atoi(argv[i] + 7));
+        }
+        else if (arg.starts_with("-j") && arg.size() > 2) // -jN
+        {
+            jobs = static_cast<unsigned>(std::atoi(argv[i] + 2));
+        }
+        else if (arg == "--line-directives") // perf, gdb and sanitizers report Nubb++ lines
+        {
+            lineDirectives = true;
+        }
+        else if (arg == "--source-map") // JSON map from out.cpp offsets to Nubb++ lines
+        {
+            sourceMap = true;
+        }
+        else if (arg == "--profile") // count executions of every line
+        {
+            profile = true;
+        }
+        else if (arg == "--trace") // timeline of every FUNCTION call
+        {
+            trace = true;
+        }
+        else if (arg == "--pgo-gen") // record branch and call counts
+        {
+            pgoGenerate = true;
+        }
+        else if (arg.starts_with("--pgo-use=")) // optimise with recorded counts
+        {
+            pgoPath = argv[i] + 10;
+        }
+        else if (arg == "--alloc-profile") // count array and string allocations
+        {
+            allocProfile = true;
+        }
+        else if (arg.starts_with("--bounds=")) // --bounds=check|hoist|off
+        {
+            std::string_view mode { arg.substr(9) };
+            if (mode == "check")
+                bounds = nubb::Options::Bounds::CHECK;
+            else if (mode == "hoist")
+                bounds = nubb::Options::Bounds::HOIST;
+            else if (mode == "off")
+                bounds = nubb::Options::Bounds::OFF;
+            else
+            {
+                std::cerr << "[FATAL] Unknown --bounds mode: " << mode << " (expected check, hoist or off)\n";
+                std::exit(1);
+            }
+        }
+        else if (!(arg.starts_with("-")) && sourcePath == nullptr)
+        {
+            sourcePath = argv[i];
+        }
+        else
+        {
+            std::cerr << "[FATAL] Unknown argument: " << arg << '\n';
+            std::exit(1);
+        }
+    }
+
+    if (jobs == 0) // -j 0 uses every core
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    if (sourcePath == nullptr) // too few arguments, no source file given
     {
         std::cerr << "[FATAL] Cannot retrieve source file argument.\n";
         std::exit(1);
     }
     else // source file given
     {
-        std::ifstream inputFile(argv[1]); // open described file from command-line argument
+        std::ifstream inputFile(sourcePath); // open described file from command-line argument
         std::string lineContent; 
         
         if (inputFile.is_open())
@@ -37,19 +123,67 @@ int main(int argc, char **argv)
         }
         else
         {
-            std::cout << "[FATAL] Unable to access file of filepath: " << argv[1];
+            std::cout << "[FATAL] Unable to access file of filepath: " << sourcePath;
             std::exit(1); 
         }
     }
 
-    Lexer lex { source }; // take source file as std::string
-    lex.init_source();    // append newline to source file then pass to parser
+    nubb::Options options {};
+    options.jobs = jobs;
+    options.log = &std::cout;
+    options.sourceName = sourcePath;
+    options.lineDirectives = lineDirectives;
+    options.sourceMap = sourceMap;
+    options.profile = profile;
+    options.trace = trace;
+    options.pgoGenerate = pgoGenerate;
+    options.allocProfile = allocProfile;
+    options.bounds = bounds;
+
+    if (pgoPath != nullptr)
+    {
+        std::ifstream pgoFile(pgoPath);
+        std::string lineContent;
+
+        if (!(pgoFile.is_open()))
+        {
+            std::cout << "[FATAL] Unable to access file of filepath: " << pgoPath << '\n';
+            std::exit(1);
+        }
+        while (std::getline(pgoFile, lineContent))
+        {
+            options.pgoProfile += lineContent + '\n';
+        }
+    }
+    nubb::Result result { nubb::compile(source, options) };
+
+    if (!(result.success))
+    {
+        for (const auto& diagnostic : result.diagnostics)
+        {
+            std::cout << "[FATAL] " << diagnostic.message << '\n';
+        }
+        std::exit(1);
+    }
 
     Emitter emit { "out.cpp" }; // construct emitter with given filename to output as C++ code
-    
-    Parser parse { std::move(lex), emit, Token {"Unknown Token", TokenType::Token::UNKNOWN}, Token {"Unknown Token", TokenType::Token::UNKNOWN} };
-    parse.init();     // call nextToken to initialize curToken and peekToken 
-    parse.program();  // then start parsing source, then writes emitted code by emitter to output file
+
+    if (!(emit.writeFile(result.cppText)))
+    {
+        std::cerr << "[FATAL] EMITTER: Couldn't access file of filepath: " << emit.fullPath << '\n';
+        std::exit(1);
+    }
+
+    if (sourceMap)
+    {
+        Emitter mapEmit { "out.cpp.map.json" };
+
+        if (!(mapEmit.writeFile(result.sourceMap)))
+        {
+            std::cerr << "[FATAL] EMITTER: Couldn't access file of filepath: " << mapEmit.fullPath << '\n';
+            std::exit(1);
+        }
+    }
 
     auto stopCompileTime = std::chrono::high_resolution_clock::now(); // get stop time of compilation
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stopCompileTime - startCompileTime);
@@ -0,0 +1,101 @@
+// Report tool for nubb_profile.txt, written by programs compiled with 'nubb++ --profile'
+// Usage: nubb-prof [profile file] [-n lines] [--source file.nubb++]
+#include <iostream>    // IO
+#include <fstream>     // file IO operations
+#include <sstream>     // parses profile lines
+#include <string>      // for std::string
+#include <string_view> // command-line arguments
+#include <vector>      // for std::vector
+#include <cstdio>      // std::printf
+#include <cstdlib>     // std::atoi
+#include <algorithm>   // std::max
+
+// One line of the profile
+struct ProfileLine
+{
+    int line {};                // Nubb++ source line
+    unsigned long long count {}; // Times it ran
+    unsigned long long ticks {}; // Time spent in the FUNCTION declared on it
+};
+
+int main(int argc, char **argv)
+{
+    std::string profilePath { "nubb_profile.txt" };
+    std::string sourcePath {};
+    int shown { 20 }; // lines to show, 0 shows them all
+
+    for (int i { 1 }; i < argc; i++)
+    {
+        std::string_view arg { argv[i] };
+
+        if (arg == "-n" && i + 1 < argc)
+            shown = std::atoi(argv[++i]);
+        else if (arg == "--source" && i + 1 < argc)
+            sourcePath = argv[++i];
+        else if (!(arg.starts_with("-")))
+            profilePath = argv[i];
+        else
+        {
+            std::cerr << "[FATAL] Unknown argument: " << arg << '\n';
+            return 1;
+        }
+    }
+
+    std::ifstream profileFile(profilePath);
+    if (!(profileFile.is_open()))
+    {
+        std::cerr << "[FATAL] Unable to access file of filepath: " << profilePath << '\n';
+        return 1;
+    }
+
+    std::string unit { "ticks" };
+    std::vector<ProfileLine> lines {};
+    std::string lineContent;
+
+    while (std::getline(profileFile, lineContent))
+    {
+        std::istringstream fields(lineContent);
+
+        if (lineContent.starts_with("# source ") && sourcePath.empty())
+            sourcePath = lineContent.substr(9);
+        else if (lineContent.starts_with("# unit "))
+            unit = lineContent.substr(7);
+        else if (!(lineContent.starts_with("#")))
+        {
+            ProfileLine entry {};
+            if (fields >> entry.line >> entry.count >> entry.ticks)
+                lines.push_back(entry);
+        }
+    }
+
+    // source text of every line, so the report shows what actually ran
+    std::vector<std::string> source { "" };
+    std::ifstream sourceFile(sourcePath);
+    while (sourceFile.is_open() && std::getline(sourceFile, lineContent))
+    {
+        size_t start { lineContent.find_first_not_of(" \t") };
+        source.push_back(start == std::string::npos ? "" : lineContent.substr(start));
+    }
+
+    unsigned long long totalCount {};
+    unsigned long long maxTicks {}; // main() or whatever FUNCTION holds the rest, callees are included in ticks
+    for (const auto& entry : lines)
+    {
+        totalCount += entry.count;
+        maxTicks = std::max(maxTicks, entry.ticks);
+    }
+
+    std::printf("Nubb++ profile of %s, FUNCTION time in %s (callees included)\n\n", sourcePath.empty() ? "unknown source" : sourcePath.c_str(), unit.c_str());
+    std::printf("%6s %14s %7s %16s %7s  %s\n", "line", "count", "%", unit.c_str(), "%", "source");
+
+    for (size_t i { 0 }; i < lines.size() && (shown == 0 || static_cast<int>(i) < shown); i++) // already sorted hottest first
+    {
+        const ProfileLine& entry { lines[i] };
+        double countShare { totalCount ? 100.0 * static_cast<double>(entry.count) / static_cast<double>(totalCount) : 0.0 };
+        double tickShare { maxTicks ? 100.0 * static_cast<double>(entry.ticks) / static_cast<double>(maxTicks) : 0.0 };
+        const char* text { entry.line > 0 && static_cast<size_t>(entry.line) < source.size() ? source[entry.line].c_str() : "" };
+
+        std::printf("%6d %14llu %6.1f%% %16llu %6.1f%%  %s\n", entry.line, entry.count, countShare, entry.ticks, tickShare, text);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "nubb.h"
+
+#include <algorithm> // std::count
+
+#include "lexer.h"    // Lexer and CompileError
+#include "parser.h"   // Parser
+#include "emitter.h"  // SourceMapping
+#include "pgo.h"      // PgoProfile
+#include "parallel.h" // ParallelParser
+
+// JSON string literal holding text
+static std::string jsonString(std::string_view text)
+{
+    std::string json { "\"" };
+
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            json += '\\';
+            json += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) // control characters
+        {
+            static constexpr char hexDigits[] { "0123456789abcdef" };
+            json += "\\u00";
+            json += hexDigits[(c >> 4) & 0xf];
+            json += hexDigits[c & 0xf];
+        }
+        else
+        {
+            json += c;
+        }
+    }
+    return json + "\"";
+}
+
+// Source map for cppText, one entry per mapped statement:
+// {"version": 1, "source": "file.nubb++", "mappings": [{"offset": 123, "line": 9, "sourceLine": 2}, ...]}
+// offset is the byte index in cppText and line the C++ line (from 1) where the code for sourceLine starts
+static std::string sourceMapJson(std::string_view cppText, size_t headerSize, const std::vector<SourceMapping>& mappings, std::string_view sourceName)
+{
+    std::string json { "{\n  \"version\": 1,\n  \"source\": " + jsonString(sourceName) + ",\n  \"mappings\": [" };
+    size_t countedPos { 0 };
+    int line { 1 };
+
+    for (size_t i { 0 }; i < mappings.size(); i++)
+    {
+        size_t offset { headerSize + mappings[i].codePos };
+        line += static_cast<int>(std::count(cppText.begin() + countedPos, cppText.begin() + offset, '\n')); // mappings are in order
+        countedPos = offset;
+
+        json += (i == 0) ? "\n    " : ",\n    ";
+        json += "{\"offset\": " + std::to_string(offset) + ", \"line\": " + std::to_string(line) + ", \"sourceLine\": " + std::to_string(mappings[i].sourceLine) + "}";
+    }
+    return json + "\n  ]\n}\n";
+}
+
+// Compile Nubb++ source to C++ code in memory
+nubb::Result nubb::compile(std::string_view source, const Options& options)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    Result result {};
+
+    result.stats.sourceBytes = source.size();
+    result.stats.lines = static_cast<int>(std::count(source.begin(), source.end(), '\n'));
+
+    try
+    {
+        Parser parse {};
+        parse.log = options.log;
+        parse.lex.log = options.log;
+        parse.lex.source = source;
+        parse.recordSourceMap = options.sourceMap;
+        parse.profile = options.profile;
+        parse.profileSource = options.sourceName;
+        parse.trace = options.trace;
+        parse.pgoGenerate = options.pgoGenerate;
+        parse.allocProfile = options.allocProfile;
+        parse.boundsCheck = options.bounds != Options::Bounds::OFF;
+        parse.boundsHoist = options.bounds == Options::Bounds::HOIST;
+
+        PgoProfile pgo { PgoProfile::parse(options.pgoProfile) };
+        if (!(options.pgoProfile.empty()))
+            parse.pgo = &pgo;
+        if (options.lineDirectives)
+            parse.lineDirectiveFile = options.sourceName.empty() ? "source.nubb++" : options.sourceName;
+
+        parse.lex.init_source(); // append newline to source then pass to parser
+        parse.init();            // call nextToken to initialize curToken and peekToken
+
+        if (options.jobs > 1)
+        {
+            ParallelParser parallel { parse, std::string(source), options.jobs };
+            parallel.program(); // parse top-level FUNCTIONs on worker threads
+        }
+        else
+        {
+            parse.program();
+        }
+
+        result.cppText = parse.emit.header + parse.emit.code;
+        result.stats.cppBytes = result.cppText.size();
+        if (options.sourceMap)
+            result.sourceMap = sourceMapJson(result.cppText, parse.emit.header.size(), parse.emit.mappings, options.sourceName);
+        result.stats.functions = parse.functionCount;
+        result.stats.statements = parse.statementCount;
+        result.success = true;
+    }
+    catch (const CompileError& error)
+    {
+        result.diagnostics.push_back(Diagnostic { error.what() });
+    }
+
+    result.stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    return result;
+}
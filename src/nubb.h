@@ -0,0 +1,61 @@
+#ifndef NUBB_H
+#define NUBB_H
+
+#include <string>      // for std::string
+#include <string_view> // for std::string_view
+#include <vector>      // for std::vector
+#include <ostream>     // for std::ostream
+#include <chrono>      // for std::chrono::microseconds
+
+// Embeddable Nubb++ compiler (libnubb). compile() keeps all of its state to itself, so any number of threads
+// can compile at once. It never touches the filesystem, only prints when given a log, and never exits.
+namespace nubb
+{
+    // Settings for a single compile
+    struct Options
+    {
+        unsigned jobs { 1 };           // Worker threads for the front end, see ParallelParser
+        std::ostream* log { nullptr }; // Where [INFO] messages go, nothing is printed if nullptr
+        std::string sourceName {};     // Name of the Nubb++ file, used by lineDirectives and the instrumented builds
+        bool lineDirectives { false }; // Emit '#line N "sourceName"' before every statement
+        bool sourceMap { false };      // Fill in Result::sourceMap
+        bool profile { false };        // Instrument the program to write nubb_profile.txt when it exits
+        bool trace { false };          // Instrument the program to write nubb_trace.json when it exits
+        bool pgoGenerate { false };    // Instrument the program to write nubb_pgo.txt when it exits
+        std::string pgoProfile {};     // Text of a nubb_pgo.txt to optimise with, ignored when empty
+        bool allocProfile { false };   // Instrument the program to write nubb_alloc.txt when it exits
+        enum class Bounds { OFF, CHECK, HOIST };
+        Bounds bounds { Bounds::OFF }; // Check array indexes, HOIST checks simple FOR loops once before they start
+    };
+
+    // Error that stopped a compile
+    struct Diagnostic
+    {
+        std::string message {}; // e.g. "Parsing error. Invalid statement at: ENDIF on line 4"
+    };
+
+    // Numbers about a compile, handy for benchmarking
+    struct Stats
+    {
+        size_t sourceBytes {};                  // Size of Nubb++ source
+        size_t cppBytes {};                     // Size of emitted C++ code
+        int lines {};                           // Lines in Nubb++ source
+        int functions {};                       // FUNCTIONs parsed
+        int statements {};                      // Statements parsed, including ones in blocks
+        std::chrono::microseconds duration {};  // Time taken by compile()
+    };
+
+    // Everything produced by a compile
+    struct Result
+    {
+        bool success { false };                 // cppText is only usable when true
+        std::string cppText {};                 // Emitted C++ code, headers included
+        std::vector<Diagnostic> diagnostics {}; // Why the compile failed
+        std::string sourceMap {};               // JSON map from cppText offsets/lines to Nubb++ lines, see Options::sourceMap
+        Stats stats {};
+    };
+
+    Result compile(std::string_view source, const Options& options = {});
+}
+
+#endif
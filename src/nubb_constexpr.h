@@ -0,0 +1,63 @@
+#ifndef NUBB_CONSTEXPR_H
+#define NUBB_CONSTEXPR_H
+
+#include <string>      // for std::string
+#include <string_view> // for std::string_view
+#include <algorithm>   // std::copy_n
+
+#include "lexer.h"   // constexpr Lexer
+#include "parser.h"  // constexpr Parser
+#include "emitter.h" // constexpr Emitter
+
+// Compile Nubb++ while the C++ compiler is running, for Nubb++ snippets embedded in C++ code:
+//
+//     constexpr auto cpp { nubb::compile<"FUNCTION main:\n    PRINT \"hi\"\n    RETURN 0\nENDFUNCTION\n">() };
+//     std::string_view code { cpp }; // emitted C++, same as libnubb or the nubb++ executable would give
+//
+// A Nubb++ error stops the C++ build at the throw in Lexer::abort() or Parser::abort(). Large snippets may need
+// a bigger -fconstexpr-ops-limit (GCC) or -fconstexpr-steps (Clang).
+namespace nubb
+{
+    // String literal that can be used as a template argument, also holds the emitted C++ code
+    template <size_t N>
+    struct FixedString
+    {
+        char text[N] {}; // Characters plus null terminator
+
+        constexpr FixedString() = default;
+        constexpr FixedString(const char (&literal)[N]) { std::copy_n(literal, N, text); }
+
+        constexpr std::string_view view() const { return std::string_view { text, N - 1 }; }
+        constexpr operator std::string_view() const { return view(); }
+    };
+
+    // Compile source to C++ code, usable in constant expressions
+    constexpr std::string compileSource(std::string_view source)
+    {
+        Parser parse { Lexer { std::string(source) }, Emitter {}, Token {"Unknown Token", TokenType::Token::UNKNOWN}, Token {"Unknown Token", TokenType::Token::UNKNOWN} };
+        parse.log = nullptr;
+        parse.lex.log = nullptr;
+        parse.emit.log = nullptr;
+
+        parse.lex.init_source();
+        parse.init();
+        parse.program();
+
+        return parse.emit.header + parse.emit.code;
+    }
+
+    // Compile Source at C++ compile time. The std::string from compileSource() can't outlive constant
+    // evaluation, so it's compiled once to get the size and again to fill a FixedString of that size.
+    template <FixedString Source>
+    consteval auto compile()
+    {
+        constexpr size_t size { compileSource(Source.view()).size() };
+
+        FixedString<size + 1> cpp {};
+        std::string code { compileSource(Source.view()) };
+        std::copy_n(code.data(), size, cpp.text);
+        return cpp;
+    }
+}
+
+#endif
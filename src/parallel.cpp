@@ -0,0 +1,457 @@
+#include "parallel.h"
+
+#include <thread>    // worker threads
+#include <atomic>    // hands out segments to workers
+#include <exception> // carries errors from workers back to the calling thread
+#include <algorithm> // std::min
+
+// Block opened by a statement during the pre-scan, so we know when we're back at the top level
+struct ScanBlock
+{
+    int kind {};                // Token kind of the statement that opened the block
+    std::string forIterator {}; // FOR or FOREACH variable, which the Parser erases from symbols at the end of the loop
+    std::vector<std::string> parameters {}; // New names declared by FUNCTION ... WITH, erased again at ENDFUNCTION
+};
+
+// Walk the tokens of the source once, splitting it at every top-level FUNCTION. Only the bits of
+// parser state that carry over between top-level statements are tracked, everything else is left to the workers.
+// Workers only ever look up identifiers that appear in their own segment, so each segment just records
+// what those identifiers meant when it started rather than a copy of every symbol declared so far.
+void ParallelParser::scan()
+{
+    Lexer lex { source };
+    lex.log = nullptr;
+    lex.init_source();
+
+    NameSet symbols {};
+    NameSet labelsDeclared {};
+    NameSet fixedArrays {};
+    NameSet constants {};
+    NameSet arrays {};
+    NameSet maps {};
+    NameSet matrices {};
+    NameSet signedInts {};
+    NameSet unsignedInts {};
+    std::vector<ScanBlock> blocks {};
+    bool hasTrailingIf { false };
+    bool statementStart { true };    // next token is the first token of a statement
+    bool skipNextNewline { false };  // 'RETURN value' skips the newline before ENDFUNCTION without counting it
+    bool pureFunction { false };     // FUNCTION statement started with PURE
+    bool generatorFunction { false };  // FUNCTION statement started with GENERATOR
+    int newlines { 0 };              // newlines counted by Parser::nl() and Parser::body()
+    int topLevelStatements { 0 };    // Parser::body() counts an extra line after every top-level statement
+
+    segments.clear();
+    segments.push_back(Segment {});
+
+    auto isType = [](int kind)
+    {
+        return kind >= TokenType::Token::INT_T && kind <= TokenType::Token::F64_T;
+    };
+
+    // 1 for unsigned whole number types, -1 for signed ones, 0 for anything else, like Parser::noteNumber()
+    auto sign = [](int kind)
+    {
+        if (kind >= TokenType::Token::U8_T && kind <= TokenType::Token::U64_T)
+            return 1;
+        if (kind == TokenType::Token::INT_T || (kind >= TokenType::Token::I8_T && kind <= TokenType::Token::I64_T))
+            return -1;
+        return 0;
+    };
+
+    // fetch next token, remembering what an identifier meant the first time the current segment sees it
+    auto next = [&]()
+    {
+        Token token { lex.getToken() };
+        Segment& segment { segments.back() };
+
+        if (token.tokenKind == TokenType::Token::IDENT && !(segment.touched.contains(token.tokenText)))
+        {
+            segment.touched.insert(token.tokenText);
+
+            if (symbols.contains(token.tokenText))
+                segment.symbols.insert(token.tokenText);
+            if (labelsDeclared.contains(token.tokenText))
+                segment.labelsDeclared.insert(token.tokenText);
+            if (fixedArrays.contains(token.tokenText))
+                segment.fixedArrays.insert(token.tokenText);
+            if (constants.contains(token.tokenText))
+                segment.constants.insert(token.tokenText);
+            if (arrays.contains(token.tokenText))
+                segment.arrays.insert(token.tokenText);
+            if (maps.contains(token.tokenText))
+                segment.maps.insert(token.tokenText);
+            if (matrices.contains(token.tokenText))
+                segment.matrices.insert(token.tokenText);
+            if (signedInts.contains(token.tokenText))
+                segment.signedInts.insert(token.tokenText);
+            if (unsignedInts.contains(token.tokenText))
+                segment.unsignedInts.insert(token.tokenText);
+        }
+        return token;
+    };
+
+    try
+    {
+        Token token { next() };
+
+        // fetch next token of the current statement, false if the statement ended early
+        auto advance = [&]()
+        {
+            token = next();
+            return token.tokenKind != TokenType::Token::NEWLINE && token.tokenKind != TokenType::Token::ENDOFFILE;
+        };
+
+        while (token.tokenKind != TokenType::Token::ENDOFFILE)
+        {
+            if (token.tokenKind == TokenType::Token::NEWLINE)
+            {
+                if (skipNextNewline)
+                    skipNextNewline = false;
+                else
+                    newlines++;
+
+                statementStart = true;
+                token = next();
+                continue;
+            }
+
+            if (!statementStart)
+            {
+                // 'RETURN value ENDFUNCTION' closes a function in the middle of a line
+                if (token.tokenKind == TokenType::Token::ENDFUNCTION && !(blocks.empty()))
+                {
+                    for (const std::string& parameter : blocks.back().parameters)
+                    {
+                        symbols.erase(parameter);
+                    }
+                    blocks.pop_back();
+                    skipNextNewline = false; // the newline after it ends the FUNCTION statement
+                }
+
+                token = next();
+                continue;
+            }
+            statementStart = false;
+
+            if (blocks.empty())
+            {
+                if (token.tokenKind == TokenType::Token::FUNCTION || token.tokenKind == TokenType::Token::PURE || token.tokenKind == TokenType::Token::GENERATOR) // top-level FUNCTION starts a new segment
+                {
+                    segments.back().endPos = token.tokenPos;
+                    segments.back().touched = NameSet {};
+                    segments.push_back(Segment { token.tokenPos, 0, newlines + topLevelStatements, token.tokenLine, hasTrailingIf });
+                }
+                topLevelStatements++;
+            }
+
+            switch (token.tokenKind)
+            {
+            case TokenType::Token::IF:
+            case TokenType::Token::ELIF:
+            case TokenType::Token::ELSE:
+            case TokenType::Token::WHILE:
+            case TokenType::Token::BENCH:
+                blocks.push_back(ScanBlock { token.tokenKind });
+                break;
+            case TokenType::Token::PARALLEL: // "PARALLEL" "FOR" ...
+                if (!(advance()))
+                    continue;
+                [[fallthrough]];
+            case TokenType::Token::FOR: // "FOR" type ident
+                if (!(advance()) || !(advance()))
+                    continue;
+
+                symbols.insert(token.tokenText);
+                blocks.push_back(ScanBlock { TokenType::Token::FOR, token.tokenText });
+                break;
+            case TokenType::Token::FOREACH: // "FOREACH" "LINE" ident
+                if (!(advance()) || !(advance()))
+                    continue;
+
+                symbols.insert(token.tokenText);
+                blocks.push_back(ScanBlock { TokenType::Token::FOREACH, token.tokenText });
+                break;
+            case TokenType::Token::PURE:      // "PURE" "FUNCTION" ...
+            case TokenType::Token::GENERATOR: // "GENERATOR" "FUNCTION" type ...
+            {
+                int kind { token.tokenKind };
+                if (!(advance()) || token.tokenKind != TokenType::Token::FUNCTION)
+                    continue;
+
+                pureFunction = kind == TokenType::Token::PURE;
+                generatorFunction = kind == TokenType::Token::GENERATOR;
+            }
+                [[fallthrough]];
+            case TokenType::Token::FUNCTION: // "FUNCTION" ["VOID"] ident ["WITH" ["MOVE"] type ident {"," ...}] ":"
+            {
+                blocks.push_back(ScanBlock { TokenType::Token::FUNCTION });
+
+                bool pure { pureFunction };
+                bool generator { generatorFunction };
+                pureFunction = false;
+                generatorFunction = false;
+                if (!(advance()))
+                    continue;
+                if (token.tokenKind == TokenType::Token::VOID_SPECIFIER && !(advance()))
+                    continue;
+                if (generator && isType(token.tokenKind)) // type of the values it YIELDs
+                {
+                    if (!(advance()))
+                        continue;
+                    if (token.tokenKind == TokenType::Token::LT)
+                    {
+                        while (token.tokenKind != TokenType::Token::GT)
+                        {
+                            if (!(advance()))
+                                break;
+                        }
+                        if (token.tokenKind != TokenType::Token::GT || !(advance()))
+                            continue;
+                    }
+                }
+
+                symbols.insert(token.tokenText);
+                if (pure)
+                    constants.insert(token.tokenText);
+
+                // a parameter name is the identifier right before a comma or the colon
+                int previousKind { token.tokenKind };
+                std::string previousText {};
+                while (advance() && token.tokenKind != TokenType::Token::COLON)
+                {
+                    if (token.tokenKind == TokenType::Token::COMMA && previousKind == TokenType::Token::IDENT && !(symbols.contains(previousText)))
+                    {
+                        symbols.insert(previousText);
+                        blocks.back().parameters.push_back(previousText);
+                    }
+                    previousKind = token.tokenKind;
+                    previousText = token.tokenText;
+                }
+                if (token.tokenKind == TokenType::Token::COLON && previousKind == TokenType::Token::IDENT && !(symbols.contains(previousText)))
+                {
+                    symbols.insert(previousText);
+                    blocks.back().parameters.push_back(previousText);
+                }
+                if (token.tokenKind != TokenType::Token::COLON)
+                    continue;
+                break;
+            }
+            case TokenType::Token::LET:   // "LET" type ident
+            case TokenType::Token::INPUT: // "INPUT" type ident
+            case TokenType::Token::CONST: // "CONST" type ident
+            {
+                bool constant { token.tokenKind == TokenType::Token::CONST };
+                if (!(advance()))
+                    continue;
+
+                if (isType(token.tokenKind))
+                {
+                    bool fixedArray { false };
+                    bool array { token.tokenKind == TokenType::Token::ARRAY_T };
+                    bool map { token.tokenKind == TokenType::Token::MAP_T };
+                    bool matrix { token.tokenKind == TokenType::Token::MATRIX_T };
+                    int number { sign(token.tokenKind) };
+                    if (!(advance()))
+                        continue;
+
+                    if (token.tokenKind == TokenType::Token::LT) // "array" "<" type ["," size] ">" or "map" "<" type "," type ">"
+                    {
+                        bool element { true };
+                        while (token.tokenKind != TokenType::Token::GT)
+                        {
+                            if (!(advance()))
+                                break;
+                            if (element && (array || matrix)) // arrays and matrices go by their elements
+                                number = sign(token.tokenKind);
+                            element = false;
+                            if (token.tokenKind == TokenType::Token::COMMA && array)
+                                fixedArray = true;
+                        }
+                        if (token.tokenKind != TokenType::Token::GT || !(advance()))
+                            continue;
+                    }
+
+                    symbols.insert(token.tokenText);
+                    if (fixedArray)
+                        fixedArrays.insert(token.tokenText);
+                    if (constant)
+                        constants.insert(token.tokenText);
+                    if (array)
+                        arrays.insert(token.tokenText);
+                    else
+                        arrays.erase(token.tokenText);
+                    if (map)
+                        maps.insert(token.tokenText);
+                    else
+                        maps.erase(token.tokenText);
+                    if (matrix)
+                        matrices.insert(token.tokenText);
+                    else
+                        matrices.erase(token.tokenText);
+                    if (number < 0)
+                        signedInts.insert(token.tokenText);
+                    else
+                        signedInts.erase(token.tokenText);
+                    if (number > 0)
+                        unsignedInts.insert(token.tokenText);
+                    else
+                        unsignedInts.erase(token.tokenText);
+                }
+                break;
+            }
+            case TokenType::Token::LABEL:
+                if (!(advance()))
+                    continue;
+
+                labelsDeclared.insert(token.tokenText);
+                break;
+            case TokenType::Token::RETURN:
+                if (!(advance()))
+                    continue;
+
+                skipNextNewline = true; // unless ENDFUNCTION follows on the same line, see above
+                break;
+            case TokenType::Token::ENDIF:
+                if (!(blocks.empty()))
+                {
+                    // IF and ELSE set hasTrailingIf once their whole block is parsed
+                    if (blocks.back().kind == TokenType::Token::IF)
+                        hasTrailingIf = true;
+                    else if (blocks.back().kind == TokenType::Token::ELSE)
+                        hasTrailingIf = false;
+
+                    blocks.pop_back();
+                }
+                break;
+            case TokenType::Token::ENDFOR:
+            case TokenType::Token::ENDFOREACH:
+                if (!(blocks.empty()))
+                {
+                    symbols.erase(blocks.back().forIterator);
+                    blocks.pop_back();
+                }
+                break;
+            case TokenType::Token::ENDFUNCTION:
+                if (!(blocks.empty()))
+                {
+                    for (const std::string& parameter : blocks.back().parameters)
+                    {
+                        symbols.erase(parameter);
+                    }
+                    blocks.pop_back();
+                }
+                break;
+            case TokenType::Token::ENDWHILE:
+            case TokenType::Token::ENDBENCH:
+                if (!(blocks.empty()))
+                    blocks.pop_back();
+                break;
+            default:
+                break;
+            }
+
+            token = next();
+        }
+    }
+    catch (const CompileError&)
+    {
+        // lexing error, the worker parsing the last segment runs into the same error and reports it
+    }
+
+    segments.back().endPos = source.size();
+    segments.back().touched = NameSet {};
+}
+
+// Parse every segment on its own worker thread then stitch the emitted code together in source order
+void ParallelParser::program()
+{
+    scan();
+    parse.prologue();
+
+    std::vector<Parser> workers(segments.size());
+    std::vector<std::exception_ptr> errors(segments.size());
+    std::atomic<size_t> nextSegment { 0 };
+
+    auto work = [&]()
+    {
+        for (size_t i { nextSegment++ }; i < segments.size(); i = nextSegment++)
+        {
+            Segment& segment { segments[i] };
+            Parser& worker { workers[i] };
+
+            worker.log = nullptr;
+            worker.lex.log = nullptr;
+            worker.lex.source = source.substr(segment.startPos, segment.endPos - segment.startPos);
+            worker.lex.curLine = segment.sourceLine;
+            worker.currentLine = segment.startLine;
+            worker.lineDirectiveFile = parse.lineDirectiveFile;
+            worker.recordSourceMap = parse.recordSourceMap;
+            worker.profile = parse.profile;
+            worker.trace = parse.trace;
+            worker.pgoGenerate = parse.pgoGenerate;
+            worker.pgo = parse.pgo;
+            worker.allocProfile = parse.allocProfile;
+            worker.boundsCheck = parse.boundsCheck;
+            worker.boundsHoist = parse.boundsHoist;
+            worker.hasTrailingIf = segment.hasTrailingIf;
+            worker.symbols = std::move(segment.symbols);
+            worker.labelsDeclared = std::move(segment.labelsDeclared);
+            worker.fixedArrays = std::move(segment.fixedArrays);
+            worker.constants = std::move(segment.constants);
+            worker.arrays = std::move(segment.arrays);
+            worker.maps = std::move(segment.maps);
+            worker.matrices = std::move(segment.matrices);
+            worker.signedInts = std::move(segment.signedInts);
+            worker.unsignedInts = std::move(segment.unsignedInts);
+
+            try
+            {
+                worker.lex.init_source();
+                worker.init();
+                worker.body();
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads {};
+    size_t threadCount { std::min<size_t>(jobs, segments.size()) };
+
+    for (size_t i { 1 }; i < threadCount; i++)
+    {
+        threads.emplace_back(work);
+    }
+    work(); // calling thread parses segments too
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i { 0 }; i < workers.size(); i++)
+    {
+        // a sequential parse stops at the first error in source order, so report that one
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+
+        for (SourceMapping mapping : workers[i].emit.mappings) // worker code gets moved along by everything before it
+        {
+            mapping.codePos += parse.emit.code.size();
+            parse.emit.mappings.push_back(mapping);
+        }
+        parse.emit.header += workers[i].emit.header; // INPUT variables
+        parse.emit.code += workers[i].emit.code;
+        parse.labelsDeclared.merge(workers[i].labelsDeclared);
+        parse.labelsGotoed.merge(workers[i].labelsGotoed);
+        parse.functionCount += workers[i].functionCount;
+        parse.statementCount += workers[i].statementCount;
+        parse.runtimeUsed.merge(workers[i].runtimeUsed);
+        parse.countedLines = std::max(parse.countedLines, workers[i].countedLines);
+    }
+
+    parse.epilogue();
+}
@@ -0,0 +1,46 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+#include "lexer.h"  // Lexer used by the pre-scan
+#include "parser.h" // Parser used by every worker
+#include "symbols.h" // parser state snapshots
+
+// A run of top-level statements starting at a FUNCTION (or at the start of the file)
+// that can be parsed without looking at any other segment
+struct Segment
+{
+    size_t startPos {};                      // Index of first character of segment in source
+    size_t endPos {};                        // Index one past the last character of segment in source
+    int startLine {};                        // Parser::currentLine at the start of the segment
+    int sourceLine { 1 };                    // Real source line the segment starts on, see Lexer::curLine
+    bool hasTrailingIf { false };            // Parser::hasTrailingIf at the start of the segment
+    NameSet symbols {};                      // Identifiers used in the segment that were declared before it starts
+    NameSet labelsDeclared {};               // Identifiers used in the segment that were LABELs before it starts
+    NameSet fixedArrays {};                  // Identifiers used in the segment that were array<type, size> before it starts
+    NameSet constants {};                    // Identifiers used in the segment that were CONSTs or PURE FUNCTIONs before it starts
+    NameSet arrays {};                       // Identifiers used in the segment that were arrays before it starts
+    NameSet maps {};                         // Identifiers used in the segment that were maps before it starts
+    NameSet matrices {};                     // Identifiers used in the segment that were matrices before it starts
+    NameSet signedInts {};                   // Identifiers used in the segment that held signed whole numbers before it starts
+    NameSet unsignedInts {};                 // Identifiers used in the segment that held unsigned whole numbers before it starts
+    NameSet touched {};                      // Identifiers seen in the segment so far, only used by the pre-scan
+};
+
+// Multi-threaded front end. FUNCTIONs can't be nested, so a cheap token pre-scan can find where every
+// top-level FUNCTION starts along with everything declared before it. Each segment then gets parsed
+// and emitted by its own Parser on a worker thread, and the output is glued back together in source order.
+struct ParallelParser
+{
+    Parser& parse;                    // Parser that owns the final Emitter and global checks
+    std::string source {};            // Source file contents, without the newline added by Lexer::init_source()
+    unsigned jobs { 1 };              // Number of worker threads to use
+    std::vector<Segment> segments {}; // Segments found by scan(), in source order
+
+    void scan();
+    void program();
+};
+
+#endif
@@ -1,13 +1,158 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-#include <cstdlib>  // std::exit
 #include <iostream> // IO
+#include <algorithm> // std::max
+#include <tuple>     // std::tie
 
 #include "lexer.h"   // Forward/include lexer so parser can use Lexer object
 #include "emitter.h" // Forward/include emitter so parser can use Emitter object 
-#include <set>       // To use sets for storing defined variables, labels, and goto'ed labels
+#include "symbols.h" // To use sets for storing defined variables, labels, and goto'ed labels
+#include "runtime.h" // C++ pasted into the output for --profile and friends
+#include "pgo.h"     // Profile read back by --pgo-use
 
+// Binding power of Nubb++ operators, higher binds tighter. Binary operators line up with C++ so the emitted code
+// needs no extra brackets. NOT binds looser than comparisons (NOT a == b is NOT (a == b)) but tighter than AND/OR,
+// so its operand gets wrapped in !( ... ).
+struct Precedence
+{
+    enum Level
+    {
+        NONE = 0,           // Not a binary operator, ends the expression
+        ASSIGNMENT = 1,     // += -=, right associative
+        OR = 2,
+        AND = 3,
+        NOT = 4,            // Prefix NOT
+        EQUALITY = 5,       // == !=
+        RELATIONAL = 6,     // < <= > >=
+        ADDITIVE = 7,       // + -
+        MULTIPLICATIVE = 8, // * /
+    };
+
+    // Binding power of a binary operator token, NONE for anything else
+    static constexpr Level of(int tokenKind)
+    {
+        switch (tokenKind)
+        {
+        case TokenType::Token::PLUSEQ:
+        case TokenType::Token::MINUSEQ:
+            return ASSIGNMENT;
+        case TokenType::Token::OR:
+            return OR;
+        case TokenType::Token::AND:
+            return AND;
+        case TokenType::Token::EQEQ:
+        case TokenType::Token::NOTEQ:
+            return EQUALITY;
+        case TokenType::Token::LT:
+        case TokenType::Token::LTEQ:
+        case TokenType::Token::GT:
+        case TokenType::Token::GTEQ:
+            return RELATIONAL;
+        case TokenType::Token::PLUS:
+        case TokenType::Token::MINUS:
+            return ADDITIVE;
+        case TokenType::Token::ASTERISK:
+        case TokenType::Token::SLASH:
+            return MULTIPLICATIVE;
+        default:
+            return NONE;
+        }
+    }
+};
+
+// Whole number types as C++, with the Nubb++ name and the range of values they hold. int is 32 bits on everything
+// Nubb++ targets, i8 to u64 are the <cstdint> types
+struct IntegerType
+{
+    std::string_view cpp {};
+    std::string_view nubb {};
+    bool isSigned {};
+    unsigned long long max {};      // Largest value
+    unsigned long long minSize {};  // Size of the most negative value, 0 if there are none
+    std::string_view range {};      // For error messages
+};
+
+constexpr IntegerType integerTypes[] {
+    { "int", "int", true, 2147483647ull, 2147483648ull, "-2147483648 to 2147483647" },
+    { "std::int8_t", "i8", true, 127ull, 128ull, "-128 to 127" },
+    { "std::int16_t", "i16", true, 32767ull, 32768ull, "-32768 to 32767" },
+    { "std::int32_t", "i32", true, 2147483647ull, 2147483648ull, "-2147483648 to 2147483647" },
+    { "std::int64_t", "i64", true, 9223372036854775807ull, 9223372036854775808ull, "-9223372036854775808 to 9223372036854775807" },
+    { "std::uint8_t", "u8", false, 255ull, 0, "0 to 255" },
+    { "std::uint16_t", "u16", false, 65535ull, 0, "0 to 65535" },
+    { "std::uint32_t", "u32", false, 4294967295ull, 0, "0 to 4294967295" },
+    { "std::uint64_t", "u64", false, 18446744073709551615ull, 0, "0 to 18446744073709551615" },
+};
+
+// Whole number type with C++ name type, nullptr for anything else
+constexpr const IntegerType* integerType(std::string_view type)
+{
+    for (const IntegerType& integer : integerTypes)
+    {
+        if (integer.cpp == type)
+            return &integer;
+    }
+    return nullptr;
+}
+
+// Element type of a C++ array or matrix type, type itself for anything else
+constexpr std::string_view numberElement(std::string_view type)
+{
+    if (type.starts_with("std::vector<") || type.starts_with("std::array<") || type.starts_with("nubb_matrix::Matrix<"))
+    {
+        type.remove_prefix(type.find('<') + 1);
+        type = type.substr(0, type.find_first_of(",>"));
+    }
+    return type;
+}
+
+// What expression() found while parsing, for statements that need more than the emitted code
+struct ExprInfo
+{
+    bool hasComparison { false };  // Contains a comparison or logical operator
+    bool hasSideEffects { false }; // Contains ++, --, += or -=
+};
+
+// An IF and the ELIFs straight after it, kept until the chain ends so --pgo-use can move the hottest arm to the front
+struct IfChain
+{
+    struct Arm
+    {
+        size_t start {};             // Index in Emitter::code of the arm's "if (" or "else if ("
+        size_t end {};               // Index one past the "}" closing the arm
+        std::string condition {};    // Emitted condition, without the --pgo-gen counting around it
+        unsigned long long hits {};  // Times the arm was taken in the profile
+    };
+
+    int depth {};                    // Parser::statementDepth of the IF
+    int line {};                     // Source line of the IF, its condition count is how often the chain ran
+    std::vector<Arm> arms {};
+};
+
+// --bounds=hoist: a FOR loop counting an int up from 0 while it's below a number or variable. If nothing in the body
+// can change the count, the bound or the size of the arrays it indexes, those indexes are checked once before the loop.
+struct HoistLoop
+{
+    struct Access
+    {
+        std::string array {};
+        int line {};                 // Source line of the first access, reported if the check fails
+    };
+
+    int line {};                     // Source line of the FOR, names its nubb_hoist_ flag
+    std::string iterator {};
+    std::string bound {};            // Number or variable the iterator stays below
+    bool inclusive { false };        // iterator <= bound rather than iterator < bound
+    std::string step {};             // Whole number the iterator goes up by each pass
+    int bodyDepth {};                // Parser::statementDepth of statements right in the loop body
+    size_t start {};                 // Index in Emitter::code of the "for (", where the checks go
+    bool safe { true };              // No CALL, GOTO, LABEL or RETURN in the body
+    NameSet written {};              // Variables the body assigns and arrays it resizes
+    std::vector<Access> accesses {}; // Arrays indexed by the iterator on every pass through the body
+};
+
+// Like the Lexer, every member function is constexpr so whole programs can be compiled inside a C++ compiler
 struct Parser
 {
     Lexer lex;
@@ -19,28 +164,2469 @@ struct Parser
     bool hasTrailingIf { false };           // Verifies correct IF/ELIF/ELSE structure 
     bool enteredFunctionBody { false };     // Ensures functions cannot be nested in functions
     int currentLine {};                     // Current line # in source file parsing, used for error messages.
+    std::ostream* log { &std::cout };       // Where [INFO] messages go, nullptr to stay quiet
+    int functionCount {};                   // FUNCTIONs parsed so far, for compile stats
+    int statementCount {};                  // Statements parsed so far, for compile stats
+    std::string lineDirectiveFile {};       // Nubb++ file named by #line directives, none are emitted when empty
+    bool recordSourceMap { false };         // Fill in emit.mappings for every statement
+    bool profile { false };                 // Count how often every statement runs, see runtime::profile
+    std::string profileSource {};           // Nubb++ file named in the --profile, --pgo-gen and --alloc-profile output
+    int countedLines {};                    // One past the last source line with a --profile or --pgo-gen counter
+    bool trace { false };                   // Record every FUNCTION call for a timeline, see runtime::trace
+    bool pgoGenerate { false };             // Count conditions and calls for a later --pgo-use compile, see runtime::pgo
+    const PgoProfile* pgo { nullptr };      // Counts from a --pgo-gen run for branch hints and ELIF order, nullptr without --pgo-use
+    int statementDepth {};                  // How many statements deep we are, top-level statements are at 1
+    std::vector<IfChain> ifChains {};       // IF chains that can still get ELIFs, innermost last
+    bool allocProfile { false };            // Count array and string allocations per declaring line, see runtime::alloc
+    NameSet runtimeUsed {};                 // Parts of runtime.h the program needs, pasted into the header by epilogue()
+    bool boundsCheck { false };             // Check every array index, see runtime::bounds
+    bool boundsHoist { false };             // With boundsCheck, check indexes of simple FOR loops once before the loop
+    std::vector<HoistLoop> hoistLoops {};   // FOR loops being parsed that boundsHoist can check up front, innermost last
+    bool conditional { false };             // Operand being parsed might not be evaluated (right of AND/OR, ELIF condition)
+    std::string lastOperand {};             // Variable primary() emitted last, empty if it emitted anything else
+    bool forCondition { false };            // Parsing the condition of a FOR, which a colon ends
+    NameSet readOnly {};                    // Parameters of the current FUNCTION passed by const reference
+    std::vector<std::string> functionParameters {}; // Parameters of the current FUNCTION that weren't symbols before it
+    bool pureBody { false };                // Parsing a PURE FUNCTION, which the C++ compiler may run
+    bool constantValue { false };           // Parsing the value of a CONST
+    NameSet pureLocals {};                  // Parameters and variables of the current PURE FUNCTION
+    std::tuple<bool, bool, bool, bool> instrumented {}; // profile, trace, pgoGenerate and allocProfile outside the PURE FUNCTION
+    bool parallelBody { false };            // Parsing the body of a PARALLEL FOR, which runs on many threads at once
+    NameSet parallelLocals {};              // Variables of the current PARALLEL FOR body, every thread has its own
+    NameSet reduced {};                     // REDUCE variables of the current PARALLEL FOR, every thread adds to its own copy
+    bool elementwise { false };             // Parsing a whole-array expression, where an array stands for its element nubb_i
+    std::vector<std::string> elementArrays {};   // Arrays used by the current whole-array expression
+    std::vector<std::string> elementCaptures {}; // Values in it worked out once instead of for every element
+    bool generatorBody { false };           // Parsing a GENERATOR, a C++ coroutine that can YIELD
+    bool yielded { false };                 // The current GENERATOR has a YIELD
+    NameSet eachElements {};                // FOR EACH variables, references to the values they loop over
+
     
-    
-    std::set<std::string>symbols {};        // Declared variables so far
-    std::set<std::string>labelsDeclared {}; // Labels declared so far (prevent goto'ing an undefined label)
-    std::set<std::string>labelsGotoed {};   // Labels gotoed so far (prevent goto'ing an undefined label)
+    NameSet symbols {};                     // Declared variables so far
+    NameSet labelsDeclared {};              // Labels declared so far (prevent goto'ing an undefined label)
+    NameSet labelsGotoed {};                // Labels gotoed so far (prevent goto'ing an undefined label)
+    NameSet fixedArrays {};                 // Arrays declared as array<type, size>, which can't change size
+    NameSet constants {};                   // CONSTs and PURE FUNCTIONs, the only things a CONST value can use
+    NameSet arrays {};                      // Variables that are arrays of any kind
+    NameSet maps {};                        // Variables that are maps
+    NameSet matrices {};                    // Variables that are matrices
+    NameSet signedInts {};                  // Variables holding signed whole numbers, or arrays and matrices of them
+    NameSet unsignedInts {};                // Same for u8 to u64, which can't be mixed with signed ones
 
     void abort(std::string_view message);
-    void nextToken();
-    auto checkToken(TokenType::Token tokenKind);
-    auto checkPeek(TokenType::Token tokenKind);
-    std::string matchType();
-    void match(TokenType::Token tokenKind);
-    bool isComparisonOperator();
-    void nl();
-    void primary();
-    void term();
-    void unary();
-    void expression();
-    void comparison();
-    void statement();
-    void program();
-    void init();
+    constexpr void nextToken();
+    constexpr auto checkToken(TokenType::Token tokenKind);
+    constexpr auto checkPeek(TokenType::Token tokenKind);
+    constexpr std::string matchType();
+    constexpr void match(TokenType::Token tokenKind);
+    constexpr void nl();
+    constexpr std::string filePath();
+    constexpr std::string mapKey();
+    constexpr std::string matrixIndex(std::string_view matrix);
+    constexpr void noteNumber(std::string_view name, std::string_view type);
+    constexpr void checkNumber(std::string_view type);
+    constexpr std::string parameters();
+    constexpr void arguments();
+    constexpr void markSourceLine();
+    constexpr void countLine(int line);
+    constexpr void beginCondition(int line);
+    constexpr void endCondition();
+    constexpr std::string branchHint(int line, int entriesLine);
+    constexpr void closeIfChains(int depth);
+    constexpr void reorderIfChain(const IfChain& chain);
+    constexpr void insertCode(size_t pos, std::string_view code);
+    constexpr std::string arrayIndex(std::string_view array, std::string_view index);
+    constexpr void noteWrite(std::string_view name);
+    constexpr void noteRead(std::string_view name);
+    constexpr void noteCall(std::string_view name);
+    constexpr void declareLocal(std::string_view name);
+    constexpr bool elementwiseAhead();
+    constexpr std::string elementwiseExpression(int line);
+    constexpr bool beginHoistLoop(int line, std::string_view iterator, std::string_view condition, std::string_view step, size_t start);
+    constexpr void endHoistLoop();
+    constexpr void primary();
+    constexpr ExprInfo expression();
+    constexpr ExprInfo comparison();
+    constexpr void statement();
+    constexpr void program();
+    constexpr void prologue();
+    constexpr void body();
+    constexpr void epilogue();
+    constexpr void init();
 };
 
+// Stop on fatal error in Parsing process, not constexpr for the same reason as Lexer::abort()
+inline void Parser::abort(std::string_view message)
+{
+    throw CompileError("Parsing error. " + std::string(message));
+}
+
+// Fetch next token and peek for next token in source
+constexpr void Parser::nextToken()
+{
+    curToken = peekToken;
+    peekToken = lex.getToken();
+}
+
+// Verify token match for valid statements
+constexpr auto Parser::checkToken(TokenType::Token tokenKind)
+{
+    return tokenKind == curToken.tokenKind;
+}
+
+// Ensure following token matches for valid statements
+constexpr auto Parser::checkPeek(TokenType::Token tokenKind)
+{
+    return tokenKind == peekToken.tokenKind;
+}
+
+// Check that given type for a statement is valid, abort parsing otherwise
+constexpr std::string Parser::matchType()
+{
+    if ((curToken.tokenKind == TokenType::Token::INT_T) || (curToken.tokenKind == TokenType::Token::FLOAT_T) || (curToken.tokenKind == TokenType::Token::DOUBLE_T) || (curToken.tokenKind == TokenType::Token::BOOL_T) || (curToken.tokenKind == TokenType::Token::AUTO_T))
+    {
+        std::string tempType { curToken.tokenText }; // implemented so we can run nextToken() before exiting       
+        nextToken();
+        return tempType;
+    }
+    else if (curToken.tokenKind == TokenType::Token::STRING_T)
+    {    
+        nextToken();
+        return "std::string";
+    }
+    else if (curToken.tokenKind >= TokenType::Token::I8_T && curToken.tokenKind <= TokenType::Token::F64_T) // i8 to u64 are <cstdint> types, f32 and f64 are float and double
+    {
+        std::string bits { curToken.tokenText.substr(1) };
+        bool isUnsigned { curToken.tokenKind >= TokenType::Token::U8_T && curToken.tokenKind <= TokenType::Token::U64_T };
+        bool isFloat { curToken.tokenKind == TokenType::Token::F32_T || curToken.tokenKind == TokenType::Token::F64_T };
+        nextToken();
+
+        if (isFloat)
+            return bits == "32" ? "float" : "double";
+        return (isUnsigned ? "std::uint" : "std::int") + bits + "_t";
+    }
+    else if (curToken.tokenKind == TokenType::Token::ARRAY_T)
+    {
+        nextToken();
+        if (!(checkToken(TokenType::Token::LT))) // untyped array, C++ deduces the element type from its values
+            return "std::vector";
+
+        // array<type> grows with ADD, array<type, size> has a fixed size and lives on the stack
+        nextToken();
+        std::string elementType { matchType() };
+        if (elementType == "auto" || elementType.starts_with("std::vector") || elementType.starts_with("std::array") || elementType.starts_with("nubb_"))
+            abort("Array elements need a type like int or string, got: " + elementType + " on line " + toString(currentLine+1));
+
+        if (checkToken(TokenType::Token::COMMA))
+        {
+            nextToken();
+            std::string size { curToken.tokenText };
+            if (!(checkToken(TokenType::Token::NUMBER)) || size.find('.') != std::string::npos)
+                abort("Array size has to be a whole number, got: " + size + " on line " + toString(currentLine+1));
+
+            nextToken();
+            match(TokenType::Token::GT);
+            return "std::array<" + elementType + ", " + size + ">";
+        }
+
+        match(TokenType::Token::GT);
+        if (elementType == "bool") // 64 to a word, see runtime::bits
+        {
+            runtimeUsed.insert("bits");
+            return "nubb_bits::Bits";
+        }
+        return "std::vector<" + elementType + ">";
+    }
+    else if (curToken.tokenKind == TokenType::Token::MAP_T) // map<key, value>, a hash table
+    {
+        nextToken();
+        match(TokenType::Token::LT);
+
+        std::string keyType { matchType() };
+        if (keyType == "auto" || keyType.starts_with("std::vector") || keyType.starts_with("std::array") || keyType.starts_with("nubb_"))
+            abort("Map keys need a type like int or string, got: " + keyType + " on line " + toString(currentLine+1));
+
+        match(TokenType::Token::COMMA);
+        std::string valueType { matchType() };
+        if (valueType == "auto" || valueType == "std::vector")
+            abort("Map values need a type like int or array<int>, got: " + valueType + " on line " + toString(currentLine+1));
+
+        match(TokenType::Token::GT);
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("map");
+        return "nubb_map::Map<" + keyType + ", " + valueType + ">";
+    }
+    else if (curToken.tokenKind == TokenType::Token::MATRIX_T) // matrix<type>, rows and columns in one block of memory
+    {
+        nextToken();
+        match(TokenType::Token::LT);
+
+        std::string elementType { matchType() };
+        if (!(integerType(elementType)) && elementType != "float" && elementType != "double")
+            abort("Matrix elements need to be numbers like int or double, got: " + elementType + " on line " + toString(currentLine+1));
+
+        match(TokenType::Token::GT);
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("matrix");
+        return "nubb_matrix::Matrix<" + elementType + ">";
+    }
+    else
+    {
+        abort("Last statement couldn't use type: " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+    
+    return "auto";
+}
+
+// Match tokens in statements with source file tokens, abort if token is invalid or otherwise not present
+constexpr void Parser::match(TokenType::Token tokenKind)
+{
+    if (!(checkToken(tokenKind)))
+    { 
+       abort("Expected token enum: " + toString(tokenKind) + ", got: " + toString(curToken.tokenKind) + " on line " + toString(currentLine+1));
+    }
+    nextToken();
+}
+
+// Path given to FOREACH LINE or WRITE, a string or a string variable, as C++
+constexpr std::string Parser::filePath()
+{
+    std::string path { curToken.tokenText };
+    if (checkToken(TokenType::Token::STRING))
+        path = "\"" + path + "\"";
+    else if (!(checkToken(TokenType::Token::IDENT)) || !(symbols.contains(path)))
+        abort("Expected a file path string or variable, got: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+    nextToken();
+    return path;
+}
+
+// Key of a map lookup, INSERT or ERASE as C++. Like an array index it's a single token, so 'INSERT m: k: v' isn't
+// read as indexing k
+constexpr std::string Parser::mapKey()
+{
+    std::string key { curToken.tokenText };
+    if (checkToken(TokenType::Token::MINUS))
+    {
+        nextToken();
+        key = "-" + curToken.tokenText;
+        if (!(checkToken(TokenType::Token::NUMBER)))
+            abort("Expected a number after '-' in map key, got: " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+    else if (checkToken(TokenType::Token::STRING))
+    {
+        key = "\"" + key + "\"";
+    }
+    else if (checkToken(TokenType::Token::TRUE) || checkToken(TokenType::Token::FALSE))
+    {
+        key = checkToken(TokenType::Token::TRUE) ? "true" : "false";
+    }
+    else if (checkToken(TokenType::Token::IDENT))
+    {
+        if (!(symbols.contains(key)))
+            abort("Referencing variable before assignment: " + key + " on line " + toString(currentLine+1));
+        noteRead(key);
+    }
+    else if (!(checkToken(TokenType::Token::NUMBER)))
+    {
+        abort("Expected a map key, got: " + key + " on line " + toString(currentLine+1));
+    }
+
+    nextToken();
+    return key;
+}
+
+// ":" index ":" index after a matrix, as C++. Row i starts i * columns elements into the matrix's memory, checked
+// against both sizes with --bounds
+constexpr std::string Parser::matrixIndex(std::string_view matrix)
+{
+    std::string indexes[2] {};
+    int line { curToken.tokenLine };
+    for (std::string& index : indexes)
+    {
+        match(TokenType::Token::COLON);
+        index = curToken.tokenText;
+        if (checkToken(TokenType::Token::IDENT))
+        {
+            if (!(symbols.contains(index)))
+                abort("Referencing variable before assignment: " + index + " on line " + toString(currentLine+1));
+            noteRead(index);
+        }
+        else if (!(checkToken(TokenType::Token::NUMBER)))
+        {
+            abort("Matrix index has to be a number or variable, got: " + index + " on line " + toString(currentLine+1));
+        }
+        nextToken();
+    }
+
+    if (boundsCheck)
+        return std::string(matrix) + ".at(" + indexes[0] + ", " + indexes[1] + ", " + toString(line) + ")";
+    return std::string(matrix) + "(" + indexes[0] + ", " + indexes[1] + ")";
+}
+
+// Sort a newly declared variable (or the elements of an array or matrix) of C++ type into signedInts or unsignedInts
+constexpr void Parser::noteNumber(std::string_view name, std::string_view type)
+{
+    const IntegerType* integer { integerType(numberElement(type)) };
+    if (integer && integer->isSigned)
+        signedInts.insert(name);
+    else
+        signedInts.erase(name);
+    if (integer && !(integer->isSigned))
+        unsignedInts.insert(name);
+    else
+        unsignedInts.erase(name);
+}
+
+// A number written straight into a whole number variable (all of the value after "=", or one value in an array's
+// list) has to fit its type. C++ would cut it down to size without a word, or stop with an error about narrowing.
+// Anything longer is worked out at runtime and wraps around, see statement()
+constexpr void Parser::checkNumber(std::string_view type)
+{
+    const IntegerType* integer { integerType(type) };
+    bool negative { checkToken(TokenType::Token::MINUS) };
+    const Token& number { negative ? peekToken : curToken };
+    int after { negative ? lex.lookAhead(1).tokenKind : peekToken.tokenKind };
+    if (!(integer) || number.tokenKind != TokenType::Token::NUMBER || (after != TokenType::Token::NEWLINE && after != TokenType::Token::COMMA))
+        return;
+
+    std::string written { (negative ? "-" : "") + number.tokenText };
+    if (number.tokenText.find('.') != std::string::npos)
+        abort("Number " + written + " has a fraction, it can't be stored in " + std::string(integer->nubb) + " on line " + toString(currentLine+1));
+
+    unsigned long long size { 0 };
+    bool fits { true };
+    for (char c : number.tokenText)
+    {
+        unsigned long long digit { static_cast<unsigned long long>(c - '0') };
+        fits = fits && size <= (18446744073709551615ull - digit) / 10;
+        size = size * 10 + digit;
+    }
+    if (!(fits) || size > (negative ? integer->minSize : integer->max))
+        abort("Number " + written + " doesn't fit in " + std::string(integer->nubb) + ", which holds " + std::string(integer->range) + " on line " + toString(currentLine+1));
+}
+
+// "WITH" parameter {"," parameter} after a FUNCTION name, as a C++ parameter list. Numbers and bools are copied,
+// arrays and strings are passed by const reference so they can't be changed, unless "MOVE" gives the function its own
+// one (the caller MOVEs theirs in, or pays for a copy)
+constexpr std::string Parser::parameters()
+{
+    std::string list {};
+    if (!(checkToken(TokenType::Token::WITH)))
+        return list;
+
+    do
+    {
+        nextToken(); // skip WITH or comma
+        bool move { checkToken(TokenType::Token::MOVE) };
+        if (move)
+            nextToken();
+
+        std::string type { matchType() };
+        std::string name { curToken.tokenText };
+        match(TokenType::Token::IDENT);
+
+        // untyped arrays, and counted ones with --alloc-profile, have no single C++ type to spell out
+        bool isArray { type.starts_with("std::vector") || type.starts_with("std::array") || type.starts_with("nubb_bits") };
+        bool isMap { type.starts_with("nubb_map") };
+        bool isMatrix { type.starts_with("nubb_matrix") };
+        bool large { type == "std::string" || isArray || isMap || isMatrix };
+        noteNumber(name, type);
+        if (large && (type == "std::vector" || allocProfile))
+            type = "auto";
+
+        if (isArray)
+            arrays.insert(name);
+        else
+            arrays.erase(name);
+        if (isMap)
+            maps.insert(name);
+        else
+            maps.erase(name);
+        if (isMatrix)
+            matrices.insert(name);
+        else
+            matrices.erase(name);
+
+        if (!(list.empty()))
+            list += ", ";
+        if (move || !(large) || generatorBody) // a GENERATOR outlives the CALL, so it keeps copies
+        {
+            list += type + " " + name;
+        }
+        else
+        {
+            list += "const " + type + "& " + name;
+            readOnly.insert(name);
+        }
+
+        declareLocal(name);
+        if (!(symbols.contains(name))) // gone again after ENDFUNCTION
+        {
+            symbols.insert(name);
+            functionParameters.push_back(name);
+        }
+    } while (checkToken(TokenType::Token::COMMA));
+
+    return list;
+}
+
+// ["WITH" expression {"," expression}] after a CALL, as C++ arguments
+constexpr void Parser::arguments()
+{
+    if (!(checkToken(TokenType::Token::WITH)))
+        return;
+
+    nextToken();
+    expression();
+    while (checkToken(TokenType::Token::COMMA))
+    {
+        emit.emit(", ");
+        nextToken();
+        expression();
+    }
+}
+
+// Point debuggers, profilers and sanitizers at the Nubb++ line of the statement about to be emitted,
+// using a #line directive and/or a source map entry. Skipped if the statement starts partway through a C++ line.
+constexpr void Parser::markSourceLine()
+{
+    // FUNCTION is counted inside its body, ELIF and ELSE inside their blocks so they stay attached to the IF.
+    // Statements outside of functions (global LETs and CONSTs) have no code to put a counter in.
+    bool countable { statementDepth > 1 && !(checkToken(TokenType::Token::ELIF)) && !(checkToken(TokenType::Token::ELSE)) };
+
+    if (lineDirectiveFile.empty() && !(recordSourceMap))
+    {
+        if (countable)
+            countLine(curToken.tokenLine);
+        return;
+    }
+    if (!(emit.code.empty()) && emit.code.back() != '\n') // #line has to start its own line
+        return;
+
+    if (!(lineDirectiveFile.empty()))
+        emit.emitLine("#line " + toString(curToken.tokenLine) + " " + cppString(lineDirectiveFile));
+
+    if (recordSourceMap)
+        emit.mapSourceLine(curToken.tokenLine);
+    if (countable)
+        countLine(curToken.tokenLine);
+}
+
+// --profile: bump the execution counter of a source line
+constexpr void Parser::countLine(int line)
+{
+    if (!(profile))
+        return;
+
+    emit.emit("++nubb_profile::counts[" + toString(line) + "]; ");
+    countedLines = std::max(countedLines, line + 1);
+}
+
+// --pgo-gen: start counting the condition on line, endCondition() closes it
+constexpr void Parser::beginCondition(int line)
+{
+    if (!(pgoGenerate))
+        return;
+
+    emit.emit("nubb_pgo::branch(" + toString(line) + ", ");
+    countedLines = std::max(countedLines, line + 1);
+}
+
+constexpr void Parser::endCondition()
+{
+    if (pgoGenerate)
+        emit.emit(")");
+}
+
+// --pgo-use: [[likely]] or [[unlikely]] for the condition on line, out of the times the one on entriesLine was checked
+constexpr std::string Parser::branchHint(int line, int entriesLine)
+{
+    if (!(pgo))
+        return "";
+    return pgo->branchHint(pgo->at(pgo->taken, line), pgo->at(pgo->evaluated, entriesLine));
+}
+
+// End every IF chain opened at depth or deeper, no more ELIFs can join them
+constexpr void Parser::closeIfChains(int depth)
+{
+    while (!(ifChains.empty()) && ifChains.back().depth >= depth)
+    {
+        reorderIfChain(ifChains.back());
+        ifChains.pop_back();
+    }
+}
+
+// --pgo-use: put the arms of an ended IF chain in order of how often they were taken. Only done when the order
+// can't change what runs: every condition is 'x == literal' on the same x with a different integer literal, so at
+// most one of them is ever true and none of them has side effects. Swapping arms around keeps the code the same
+// length, so offsets kept by enclosing chains stay valid.
+constexpr void Parser::reorderIfChain(const IfChain& chain)
+{
+    if (chain.arms.size() < 2 || recordSourceMap) // source map offsets inside the arms would go stale
+        return;
+
+    std::string_view subject {};
+    std::vector<std::string> values {};
+
+    for (size_t i { 0 }; i < chain.arms.size(); i++)
+    {
+        const IfChain::Arm& arm { chain.arms[i] };
+
+        // anything between the arms (#line directives, an ELSE out of place) has to stay where it is
+        if (i + 1 < chain.arms.size() && arm.end != chain.arms[i + 1].start)
+            return;
+
+        std::string_view condition { arm.condition };
+        size_t equals { condition.find("==") };
+        if (equals == std::string_view::npos)
+            return;
+
+        std::string_view name { condition.substr(0, equals) };
+        std::string_view literal { condition.substr(equals + 2) };
+
+        if (name.empty() || !(Lexer::isAlpha(name.front())))
+            return;
+        for (char c : name)
+        {
+            if (!(Lexer::isAlnum(c)) && c != '_')
+                return;
+        }
+
+        // normalise the literal so 2, +2 and 002 count as the same value
+        bool negative { !(literal.empty()) && literal.front() == '-' };
+        if (!(literal.empty()) && (literal.front() == '-' || literal.front() == '+'))
+            literal.remove_prefix(1);
+        if (literal.empty())
+            return;
+        for (char c : literal)
+        {
+            if (!(Lexer::isDigit(c)))
+                return;
+        }
+        while (literal.size() > 1 && literal.front() == '0')
+        {
+            literal.remove_prefix(1);
+        }
+        std::string value { (negative && literal != "0") ? "-" + std::string(literal) : std::string(literal) };
+
+        if (subject.empty())
+            subject = name;
+        else if (name != subject)
+            return;
+
+        for (const auto& seen : values)
+        {
+            if (seen == value) // same value twice, only the first arm can ever run
+                return;
+        }
+        values.push_back(value);
+    }
+
+    std::vector<IfChain::Arm> arms { chain.arms };
+    std::stable_sort(arms.begin(), arms.end(), [](const IfChain::Arm& a, const IfChain::Arm& b) { return a.hits > b.hits; });
+
+    std::string reordered {};
+    for (size_t i { 0 }; i < arms.size(); i++)
+    {
+        std::string_view text { std::string_view { emit.code }.substr(arms[i].start, arms[i].end - arms[i].start) };
+        reordered += (i == 0) ? "if " : "else if ";
+        reordered += text.substr(text.find('(')); // drop the "if " or "else if " the arm had
+    }
+
+    size_t start { chain.arms.front().start };
+    emit.code.replace(start, chain.arms.back().end - start, reordered);
+}
+
+// nl ::= '\n'+
+constexpr void Parser::nl()
+{
+    match(TokenType::Token::NEWLINE);            // ensure we have a newline with current statement
+    currentLine++;
+    while(checkToken(TokenType::Token::NEWLINE)) // handle newlines until all newlines are parsed
+    {
+        nextToken();
+        currentLine++;
+    }
+}
+
+// Put code into the emitted code at pos, moving anything that remembers an offset after it along
+constexpr void Parser::insertCode(size_t pos, std::string_view code)
+{
+    emit.insert(pos, code);
+    for (IfChain& chain : ifChains)
+    {
+        for (IfChain::Arm& arm : chain.arms)
+        {
+            if (arm.start > pos)
+                arm.start += code.size();
+            if (arm.end > pos)
+                arm.end += code.size();
+        }
+    }
+}
+
+// Index into array as C++, checked with --bounds. Accesses by the iterator of a hoistable FOR loop that happen on every
+// pass through its body use the loop's nubb_hoist_ flag, so the check disappears if endHoistLoop() checks up front.
+constexpr std::string Parser::arrayIndex(std::string_view array, std::string_view index)
+{
+    if (!(boundsCheck))
+        return std::string(index);
+
+    runtimeUsed.insert("print");
+    runtimeUsed.insert("bounds");
+    std::string arguments { std::string(array) + ", " + std::string(index) + ", " + toString(curToken.tokenLine) };
+
+    for (size_t i { hoistLoops.size() }; i-- > 0;)
+    {
+        HoistLoop& loop { hoistLoops[i] };
+        if (loop.iterator != index)
+            continue;
+        if (statementDepth != loop.bodyDepth || conditional) // might be skipped, check it where it is
+            break;
+
+        bool seen { false };
+        for (const HoistLoop::Access& access : loop.accesses)
+        {
+            seen = seen || access.array == array;
+        }
+        if (!(seen))
+            loop.accesses.push_back(HoistLoop::Access { std::string(array), curToken.tokenLine });
+
+        return "nubb_bounds::at<nubb_hoist_" + toString(loop.line) + ">(" + arguments + ")";
+    }
+    return "nubb_bounds::at(" + arguments + ")";
+}
+
+// A statement assigned to a variable or resized an array, which hoisted bounds checks can't allow
+constexpr void Parser::noteWrite(std::string_view name)
+{
+    if (readOnly.contains(name))
+        abort("Cannot change parameter: " + std::string(name) + ", it's passed by const reference (take it with MOVE for a copy of your own) on line " + toString(currentLine+1));
+    if (constants.contains(name))
+        abort("Cannot change CONST: " + std::string(name) + " on line " + toString(currentLine+1));
+    if (eachElements.contains(name))
+        abort("Cannot change FOR EACH variable: " + std::string(name) + ", it refers to the value it loops over on line " + toString(currentLine+1));
+    if (pureBody && !(pureLocals.contains(name)))
+        abort("PURE function cannot change variable: " + std::string(name) + ", only its own variables on line " + toString(currentLine+1));
+    if (parallelBody && !(parallelLocals.contains(name)) && !(reduced.contains(name)))
+        abort("PARALLEL FOR cannot change shared variable: " + std::string(name) + ", every thread would write it at once (use REDUCE " + std::string(name) + ":+ for a sum) on line " + toString(currentLine+1));
+
+    for (HoistLoop& loop : hoistLoops)
+    {
+        loop.written.insert(name);
+    }
+}
+
+// A variable or function is used. CONST values and PURE FUNCTIONs are worked out by the C++ compiler,
+// so they can only use what it knows about
+constexpr void Parser::noteRead(std::string_view name)
+{
+    if (constantValue && !(constants.contains(name)))
+        abort("CONST value can only use numbers, other CONSTs and PURE functions, not: " + std::string(name) + " on line " + toString(currentLine+1));
+    if (pureBody && !(pureLocals.contains(name)) && !(constants.contains(name)))
+        abort("PURE function can only use its parameters, its own variables, CONSTs and PURE functions, not: " + std::string(name) + " on line " + toString(currentLine+1));
+}
+
+// A FUNCTION is called, which could change anything unless it's PURE
+constexpr void Parser::noteCall(std::string_view name)
+{
+    noteRead(name);
+    if (parallelBody && !(constants.contains(name)))
+        abort("PARALLEL FOR can only CALL PURE functions, not: " + std::string(name) + " on line " + toString(currentLine+1));
+
+    for (HoistLoop& loop : hoistLoops)
+    {
+        loop.safe = false;
+    }
+}
+
+// A variable is declared, belonging to the PURE FUNCTION or PARALLEL FOR body it's in
+constexpr void Parser::declareLocal(std::string_view name)
+{
+    if (pureBody)
+        pureLocals.insert(name);
+    if (parallelBody)
+        parallelLocals.insert(name);
+}
+
+// Whether the value after the "=" in 'LET name = ...' is a whole-array expression like 'a + b * 2': it uses an array
+// without indexing it and isn't a list of values (which always ends in a comma)
+constexpr bool Parser::elementwiseAhead()
+{
+    std::vector<Token> tokens { lex.restOfLine() }; // everything after peekToken, which is the "="
+    if (tokens.empty() || tokens.back().tokenKind == TokenType::Token::COMMA)
+        return false;
+
+    for (size_t i { 0 }; i < tokens.size(); i++)
+    {
+        bool indexed { i + 1 < tokens.size() && tokens[i + 1].tokenKind == TokenType::Token::COLON };
+        bool builtin { i > 0 && tokens[i - 1].tokenKind >= TokenType::Token::SUM && tokens[i - 1].tokenKind <= TokenType::Token::FIND }; // SUM a is one value
+        if (tokens[i].tokenKind == TokenType::Token::IDENT && arrays.contains(tokens[i].tokenText) && !(indexed) && !(builtin))
+            return true;
+    }
+    return false;
+}
+
+// The arguments of nubb_array::map/assign for a whole-array expression: the line, a lambda working out element nubb_i
+// and the arrays in it, which have to be the same size. Everything happens in one loop with no arrays in between.
+constexpr std::string Parser::elementwiseExpression(int line)
+{
+    elementwise = true;
+    elementArrays.clear();
+    elementCaptures.clear();
+
+    size_t start { emit.code.size() };
+    expression();
+    std::string element { emit.code.substr(start) };
+    emit.code.resize(start);
+    elementwise = false;
+
+    std::string arguments { toString(line) + ", [&" };
+    for (const std::string& capture : elementCaptures)
+    {
+        arguments += ", " + capture;
+    }
+    arguments += "](size_t nubb_i) { return " + element + "; }";
+    for (const std::string& array : elementArrays)
+    {
+        arguments += ", " + array;
+    }
+
+    runtimeUsed.insert("print");
+    runtimeUsed.insert("bits"); // whole-array comparisons give packed array<bool>s
+    runtimeUsed.insert("elementwise");
+    return arguments;
+}
+
+// Start tracking an int FOR loop if its header is 'i < bound' or 'i <= bound' stepped by 'i++' or 'i += number'.
+// The iterator starts at 0, so it then only ever takes values from 0 up to the bound.
+constexpr bool Parser::beginHoistLoop(int line, std::string_view iterator, std::string_view condition, std::string_view step, size_t start)
+{
+    auto isNumber = [](std::string_view text)
+    {
+        return !(text.empty()) && text.find_first_not_of("0123456789.") == std::string_view::npos;
+    };
+
+    std::string_view bound { condition.substr(std::min(iterator.size(), condition.size())) };
+    if (!(condition.starts_with(iterator)) || !(bound.starts_with("<")))
+        return false;
+
+    bool inclusive { bound.starts_with("<=") };
+    bound.remove_prefix(inclusive ? 2 : 1);
+    if (!(isNumber(bound)) && !(symbols.contains(bound)))
+        return false;
+
+    // the check works out the last index from the step, so it has to be a whole number above 0
+    std::string_view stepBy { step.substr(std::min(iterator.size(), step.size())) };
+    if (!(step.starts_with(iterator)))
+        return false;
+    if (stepBy == "++")
+        stepBy = "1";
+    else if (stepBy.starts_with("+="))
+        stepBy.remove_prefix(2);
+    else
+        return false;
+    if (stepBy.empty() || stepBy.find_first_not_of("0123456789") != std::string_view::npos || stepBy.find_first_not_of('0') == std::string_view::npos)
+        return false;
+
+    hoistLoops.push_back(HoistLoop { line, std::string(iterator), std::string(bound), inclusive, std::string(stepBy), statementDepth + 1, start });
+    return true;
+}
+
+// Finish the innermost hoistable FOR loop. When the body left the iterator, the bound and the indexed arrays alone
+// (and can't jump out early), one check per array goes in front of the loop and the ones inside turn off.
+constexpr void Parser::endHoistLoop()
+{
+    HoistLoop loop { std::move(hoistLoops.back()) };
+    hoistLoops.pop_back();
+
+    if (loop.accesses.empty()) // nothing refers to the flag
+        return;
+
+    bool safe { loop.safe && !(loop.written.contains(loop.iterator)) && !(loop.written.contains(loop.bound)) };
+    for (const HoistLoop::Access& access : loop.accesses)
+    {
+        safe = safe && !(loop.written.contains(access.array));
+    }
+
+    emit.headerLine("constexpr bool nubb_hoist_" + toString(loop.line) + " { " + (safe ? "true" : "false") + " };");
+    if (!(safe))
+        return;
+
+    std::string checks {};
+    for (const HoistLoop::Access& access : loop.accesses)
+    {
+        checks += "nubb_bounds::loop(" + access.array + ", " + loop.bound + ", " + (loop.inclusive ? "true" : "false") + ", " + loop.step + ", " + toString(access.line) + ");\n";
+    }
+    insertCode(loop.start, checks);
+}
+
+// primary ::= number | ident | bool
+constexpr void Parser::primary()
+{
+    lastOperand.clear();
+
+    // in a whole-array expression, values that are the same for every element are worked out once before the loop.
+    // That includes reads like 'a: 0', which 'LET a = a - a: 0' would otherwise see after overwriting them
+    bool indexed { checkToken(TokenType::Token::IDENT) && checkPeek(TokenType::Token::COLON) };
+    if (elementwise && (indexed || checkToken(TokenType::Token::CALL) || checkToken(TokenType::Token::SUM) || checkToken(TokenType::Token::MIN) ||
+        checkToken(TokenType::Token::MAX) || checkToken(TokenType::Token::FIND)))
+    {
+        elementwise = false;
+        size_t start { emit.code.size() };
+        primary();
+        std::string value { emit.code.substr(start) };
+        emit.code.resize(start);
+        elementwise = true;
+
+        std::string name { "nubb_value" + toString(static_cast<long long>(elementCaptures.size())) };
+        elementCaptures.push_back(name + " = " + value);
+        emit.emit(name);
+        return;
+    }
+
+    if (checkToken(TokenType::Token::NUMBER)) // constant integral literal
+    {
+        // a whole number is an int, or an i64 when it doesn't fit, like in C++. Past that only u64 can hold it,
+        // which C++ has to be told with a suffix
+        std::string_view digits { curToken.tokenText };
+        bool whole { digits.find('.') == std::string_view::npos };
+        auto above = [&](std::string_view limit) { return digits.size() > limit.size() || (digits.size() == limit.size() && digits > limit); };
+        if (whole && above("18446744073709551615"))
+            abort("Number " + curToken.tokenText + " is too big for any whole number type, the biggest is u64 on line " + toString(currentLine+1));
+
+        emit.emit(curToken.tokenText + (whole && above("9223372036854775807") ? "ull" : ""));
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::TRUE)) // boolean literal
+    {
+        emit.emit("true");
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::FALSE)) // boolean literal
+    {
+        emit.emit("false");
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::NONE))  // boolean literal
+    {
+        emit.emit("NULL");
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::CALL)) // "CALL" ident ["WITH" arguments], value returned by a function
+    {
+        nextToken();
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot call an undefined function on line " + toString(currentLine+1));
+        noteCall(curToken.tokenText);
+
+        emit.emit(curToken.tokenText + "(");
+        nextToken();
+        arguments();
+        emit.emit(")");
+        lastOperand.clear(); // the arguments set it
+    }
+    else if (checkToken(TokenType::Token::SUM) || checkToken(TokenType::Token::MIN) || checkToken(TokenType::Token::MAX)) // ("SUM" | "MIN" | "MAX") array
+    {
+        std::string function { checkToken(TokenType::Token::SUM) ? "sum" : checkToken(TokenType::Token::MIN) ? "min" : "max" };
+        std::string what { curToken.tokenText };
+        int line { curToken.tokenLine };
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot " + what + " undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteRead(curToken.tokenText);
+
+        // MIN and MAX of an empty array stop the program, SUM of one is 0
+        std::string arguments { curToken.tokenText };
+        if (function != "sum")
+            arguments += ", " + toString(line);
+        emit.emit("nubb_algo::" + function + "(" + arguments + ")");
+        nextToken();
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("algorithm");
+    }
+    else if (checkToken(TokenType::Token::FIND)) // "FIND" array ":" ["-"] primary, index of the first element equal to it or -1
+    {
+        nextToken();
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot FIND in undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteRead(curToken.tokenText);
+
+        emit.emit("nubb_algo::find(" + curToken.tokenText + ", ");
+        nextToken();
+        match(TokenType::Token::COLON);
+        if (checkToken(TokenType::Token::MINUS)) // just the one operand, so 'FIND a: x == 2' compares the index
+        {
+            emit.emit("-");
+            nextToken();
+        }
+        primary();
+        emit.emit(")");
+        lastOperand.clear();
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("algorithm");
+    }
+    else if (checkToken(TokenType::Token::TRANSPOSE) || checkToken(TokenType::Token::MULTIPLY) || checkToken(TokenType::Token::ROWSUM) ||
+        checkToken(TokenType::Token::COLSUM) || checkToken(TokenType::Token::ROWS) || checkToken(TokenType::Token::COLS)) // ("TRANSPOSE" | "ROWSUM" | "COLSUM" | "ROWS" | "COLS") matrix | "MULTIPLY" matrix ":" matrix
+    {
+        TokenType::Token kind { static_cast<TokenType::Token>(curToken.tokenKind) };
+        std::string what { curToken.tokenText };
+        int line { curToken.tokenLine };
+        nextToken();
+
+        std::string matrices[2] {};
+        for (std::string& matrix : matrices)
+        {
+            matrix = curToken.tokenText;
+            if (!(this->matrices.contains(matrix)))
+                abort("Expected a matrix after " + what + ", got: " + matrix + " on line " + toString(currentLine+1));
+            noteRead(matrix);
+            nextToken();
+
+            if (kind != TokenType::Token::MULTIPLY)
+                break;
+            if (matrices[1].empty())
+                match(TokenType::Token::COLON);
+        }
+
+        // cache blocked kernels, see runtime::matrix
+        if (kind == TokenType::Token::ROWS || kind == TokenType::Token::COLS)
+            emit.emit(matrices[0] + (kind == TokenType::Token::ROWS ? ".rows()" : ".cols()"));
+        else if (kind == TokenType::Token::MULTIPLY)
+            emit.emit("nubb_matrix::multiply(" + matrices[0] + ", " + matrices[1] + ", " + toString(line) + ")");
+        else
+            emit.emit("nubb_matrix::" + std::string(kind == TokenType::Token::TRANSPOSE ? "transpose" : kind == TokenType::Token::ROWSUM ? "rowSums" : "colSums") + "(" + matrices[0] + ")");
+        lastOperand.clear();
+    }
+    else if (checkToken(TokenType::Token::CONTAINS)) // "CONTAINS" map ":" key, whether the map has it
+    {
+        nextToken();
+        if (!(maps.contains(curToken.tokenText)))
+            abort("Expected a map after CONTAINS, got: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteRead(curToken.tokenText);
+
+        std::string map { curToken.tokenText };
+        nextToken();
+        match(TokenType::Token::COLON);
+        emit.emit(map + ".contains(" + mapKey() + ")");
+        lastOperand.clear();
+    }
+    else if (checkToken(TokenType::Token::MOVE)) // "MOVE" ident, hands an array or string over instead of copying it
+    {
+        nextToken();
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot MOVE undefined variable: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        noteWrite(curToken.tokenText); // left empty
+        emit.emit("std::move(" + curToken.tokenText + ")");
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::IDENT)) // identifier of integral type
+    {
+        if (!(symbols.contains(curToken.tokenText)))
+        {
+            abort("Referencing variable before assignment: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        }
+        else
+        {
+            noteRead(curToken.tokenText);
+
+            // in 'FOR int i: i < n: i++' the colon after n ends the condition, 'i < a: j: i++' indexes a
+            bool endsForCondition { forCondition && checkPeek(TokenType::Token::COLON) && lex.lookAhead(2).tokenKind != TokenType::Token::COLON };
+
+            if (checkPeek(TokenType::Token::COLON) && !(endsForCondition) && matrices.contains(curToken.tokenText)) // matrix element
+            {
+                std::string matrix { curToken.tokenText };
+                nextToken();
+                emit.emit(matrixIndex(matrix));
+            }
+            else if (checkPeek(TokenType::Token::COLON) && !(endsForCondition) && maps.contains(curToken.tokenText)) // map lookup, a missing key stops the program
+            {
+                std::string map { curToken.tokenText };
+                int line { curToken.tokenLine };
+
+                nextToken();
+                nextToken();
+                emit.emit(map + ".at(" + mapKey() + ", " + toString(line) + ")");
+            }
+            else if (checkPeek(TokenType::Token::COLON) && !(endsForCondition)) // array index to be emited
+            {
+                std::string array { curToken.tokenText };
+
+                nextToken();
+                nextToken();
+                if (checkToken(TokenType::Token::IDENT))
+                    noteRead(curToken.tokenText);
+                // skip over colon to get to index number, only checked against the array's size with --bounds
+                emit.emit(array + "[" + arrayIndex(array, curToken.tokenText) + "]");
+                nextToken();
+            }
+            else if (elementwise && arrays.contains(curToken.tokenText)) // stands for its element in a whole-array expression
+            {
+                if (std::find(elementArrays.begin(), elementArrays.end(), curToken.tokenText) == elementArrays.end())
+                    elementArrays.push_back(curToken.tokenText);
+                emit.emit(curToken.tokenText + "[nubb_i]");
+                nextToken();
+            }
+            else
+            {
+                lastOperand = curToken.tokenText;
+                emit.emit(curToken.tokenText);
+                nextToken(); 
+            }
+        }
+    }
+    else if (checkToken(TokenType::Token::STRING)) // string literal
+    {
+        emit.emit('\"' + curToken.tokenText + '\"'); // quotation marks cuz without them we have plain text in the output
+        nextToken();
+    }
+    else // an unknown value of unknown/imaginary type
+    {
+        abort("Unexpected primary token at: " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+}
+
+// expression ::= operand {binary operand}
+// operand ::= {"NOT"} ["+" | "-"] primary {"++" | "--"}
+// binary ::= "+=" | "-=" | "OR" | "AND" | "==" | "!=" | "<" | "<=" | ">" | ">=" | "+" | "-" | "*" | "/"
+// Operator precedence parsing driven by Precedence::of(), using an explicit stack of pending operators instead of
+// one recursive call per precedence level, so long or deeply nested expressions parse in linear time.
+constexpr ExprInfo Parser::expression()
+{
+    ExprInfo info {};
+    std::vector<int> pending {}; // Levels of operators whose right-hand side is still being parsed
+    bool outerConditional { conditional };
+    bool signedSeen { false };   // The operands since the last AND/OR include a signed whole number, or a negative one
+    bool unsignedSeen { false }; // ... or an unsigned one
+
+    while (true)
+    {
+        while (checkToken(TokenType::Token::NOT)) // logical NOT, wraps its operand in brackets
+        {
+            emit.emit("!(");
+            pending.push_back(Precedence::NOT);
+            nextToken();
+        }
+
+        // can have + or - symbol next to integral value/number
+        bool negative { checkToken(TokenType::Token::MINUS) };
+        if (checkToken(TokenType::Token::PLUS) || checkToken(TokenType::Token::MINUS))
+        {
+            // keep 'a - -b' from turning into 'a--b'
+            if (!(emit.code.empty()) && (emit.code.back() == '+' || emit.code.back() == '-'))
+                emit.emit(" ");
+
+            emit.emit(curToken.tokenText);
+            nextToken(); // fetch integral value/number after sign
+        }
+
+        // C++ turns the signed side into an unsigned number when they meet, so -1 < u is false and i - u wraps around.
+        // Comparisons and arithmetic joined by AND/OR are separate, everything between them meets
+        bool isVariable { checkToken(TokenType::Token::IDENT) };
+        signedSeen = signedSeen || (negative && checkToken(TokenType::Token::NUMBER)) || (isVariable && signedInts.contains(curToken.tokenText));
+        unsignedSeen = unsignedSeen || (isVariable && unsignedInts.contains(curToken.tokenText));
+        if (signedSeen && unsignedSeen)
+            abort("Signed and unsigned whole numbers can't be mixed, got: " + std::string(negative ? "-" : "") + curToken.tokenText + " (LET a variable of the other kind to it first) on line " + toString(currentLine+1));
+
+        primary();
+
+        // Handle ++ or -- on a single term/identifier
+        while (checkToken(TokenType::Token::PLUSPLUS) || checkToken(TokenType::Token::MINUSMINUS))
+        {
+            info.hasSideEffects = true;
+            noteWrite(lastOperand);
+            emit.emit(curToken.tokenText);
+            nextToken();
+        }
+
+        Precedence::Level level { Precedence::of(curToken.tokenKind) };
+        if (level == Precedence::NONE) // no more operators, end of expression
+            break;
+
+        // finish operators that bind at least as tightly as this one (assignment is right associative)
+        while (!(pending.empty()) && (pending.back() > level || (pending.back() == level && level != Precedence::ASSIGNMENT)))
+        {
+            if (pending.back() == Precedence::NOT)
+                emit.emit(")");
+            pending.pop_back();
+        }
+        pending.push_back(level);
+
+        if (level == Precedence::ASSIGNMENT)
+        {
+            info.hasSideEffects = true;
+            noteWrite(lastOperand);
+        }
+        else if (level != Precedence::ADDITIVE && level != Precedence::MULTIPLICATIVE)
+        {
+            info.hasComparison = true;
+        }
+
+        if (checkToken(TokenType::Token::AND) || checkToken(TokenType::Token::OR)) // logical AND/OR
+        {
+            emit.emit(checkToken(TokenType::Token::AND) ? " && " : " || ");
+            conditional = true; // short circuits, the rest of the expression might not run
+            signedSeen = false;
+            unsignedSeen = false;
+        }
+        else
+        {
+            emit.emit(curToken.tokenText);
+        }
+        nextToken();
+    }
+
+    // close brackets of any NOT operators still waiting for the end of their operand
+    for (int pendingLevel : pending)
+    {
+        if (pendingLevel == Precedence::NOT)
+            emit.emit(")");
+    }
+
+    conditional = outerConditional;
+    return info;
+}
+
+// comparison ::= expression
+// Conditions need a comparison or logical operator, unless it's an 'IF NOT ident THEN' type statement
+constexpr ExprInfo Parser::comparison()
+{
+    ExprInfo info { expression() };
+
+    if (!(info.hasComparison) && !(checkToken(TokenType::Token::THEN)))
+    {
+        abort("Expected comparison at: " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+    return info;
+}
+
+// statement ::= "PRINT" (expression | string) nl | IF comparison, etc.
+constexpr void Parser::statement()
+{
+    statementCount++;
+    statementDepth++;
+    int line { curToken.tokenLine }; // source line the statement starts on, for --profile counters
+
+    // an ELIF or ELSE carries on the chain of the IF before it, anything else ends it
+    if (checkToken(TokenType::Token::ELIF) || checkToken(TokenType::Token::ELSE))
+        closeIfChains(statementDepth + 1);
+    else
+        closeIfChains(statementDepth);
+
+    markSourceLine();
+
+    // control can leave the loop early (or come in halfway), so indexes can't be checked before it starts
+    if (checkToken(TokenType::Token::CALL) || checkToken(TokenType::Token::GOTO) || checkToken(TokenType::Token::LABEL) || checkToken(TokenType::Token::RETURN))
+    {
+        for (HoistLoop& loop : hoistLoops)
+        {
+            loop.safe = false;
+        }
+    }
+
+    // the C++ compiler can't do input/output or jump around when it runs a PURE function
+    if (pureBody && (checkToken(TokenType::Token::PRINT) || checkToken(TokenType::Token::INPUT) || checkToken(TokenType::Token::WRITE) ||
+        checkToken(TokenType::Token::FOREACH) || checkToken(TokenType::Token::GOTO) || checkToken(TokenType::Token::LABEL) || checkToken(TokenType::Token::BENCH) ||
+        checkToken(TokenType::Token::PARALLEL)))
+    {
+        abort("PURE function cannot use " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+
+    // the body of a PARALLEL FOR is a lambda run by many threads at once: output would come out jumbled and jumps can't leave it
+    if (parallelBody && (checkToken(TokenType::Token::PRINT) || checkToken(TokenType::Token::INPUT) || checkToken(TokenType::Token::WRITE) ||
+        checkToken(TokenType::Token::GOTO) || checkToken(TokenType::Token::LABEL) || checkToken(TokenType::Token::BENCH) || checkToken(TokenType::Token::PARALLEL) ||
+        checkToken(TokenType::Token::YIELD)))
+    {
+        abort("PARALLEL FOR cannot use " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+
+    if (checkToken(TokenType::Token::PRINT)) // "PRINT" (expression | string) nl
+    {
+        nextToken();                              // see if expression or string is given
+        if (checkToken(TokenType::Token::STRING)) // if string is given for PRINT argument
+        {
+            // normal print statement with given text
+            emit.emitLine("nubb_io::out.put(\"" + curToken.tokenText + "\\n" + "\");");
+            nextToken();
+        }
+        else // expression given otherwise
+        {
+            emit.emit("nubb_io::out.put(");
+            if (peekToken.tokenKind == TokenType::Token::COLON) // printing an element from an array
+            {
+                if (!(symbols.contains(curToken.tokenText))) // array undefined
+                {
+                    abort("Cannot print index content from undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+                }
+            }
+            expression(); // emit whatever expression they specified, primary() handles array indexes
+            emit.emitLine("); nubb_io::out.put('\\n');"); // close expression, ends the line like printing text does
+        }
+        runtimeUsed.insert("print");
+    }
+    else if (checkToken(TokenType::Token::ELSE)) // "ELSE" nl {statement} "ENDIF" nl 
+    {
+        if (hasTrailingIf == false)
+            abort("Cannot have ELSE statement without trailing IF statement on line " + toString(currentLine+1));
+
+        nextToken();
+        emit.emitLine("else");
+        emit.emitLine("{");
+        countLine(line);
+
+        nl();
+
+        // zero or more statements before next ENDIF statement
+        while (!(checkToken(TokenType::Token::ENDIF)))
+        {
+            statement(); // parse all statements in THEN block before next ENDIF
+        }
+        match(TokenType::Token::ENDIF); // match for ENDIF keyword when no more statements are found in THEN block
+        emit.emitLine("}");
+
+        hasTrailingIf = false; // prevent another ELIF or ELSE after current ELSE statement
+    }
+    else if (checkToken(TokenType::Token::ELIF)) // "ELIF" comparison "THEN" nl {statement} "ENDIF" nl 
+    {
+        if (hasTrailingIf == false)
+            abort("Cannot have ELIF statement without trailing IF statement on line " + toString(currentLine+1));
+
+        // ELIFs straight after an IF at the same depth join its chain
+        IfChain* chain { (!(ifChains.empty()) && ifChains.back().depth == statementDepth) ? &ifChains.back() : nullptr };
+        int chainLine { chain ? chain->line : line };
+
+        nextToken();
+        size_t armStart { emit.code.size() };
+        emit.emit("else if ("); // comparison goes inside paranthesis
+        beginCondition(line);
+        size_t conditionStart { emit.code.size() };
+        bool outerConditional { conditional };
+        conditional = true;     // only checked when everything before it in the chain was false
+        comparison();           // parse for comparison
+        conditional = outerConditional;
+        std::string condition { emit.code.substr(conditionStart) };
+        endCondition();
+
+        match(TokenType::Token::THEN); // match for THEN token after comparison
+        nl();                          // check for valid newline leading to statements after THEN keyword
+        emit.emitLine(")" + branchHint(line, chainLine)); // how often the arm was taken out of every run of the chain
+        emit.emitLine("{");
+        countLine(line);
+
+        // zero or more statements before next ENDIF statement
+        while (!(checkToken(TokenType::Token::ENDIF)))
+        {
+            statement(); // parse all statements in THEN block before ENDIF
+        }
+        
+        match(TokenType::Token::ENDIF); // match for ENDIF keyword when no more statements are found in THEN block
+        emit.emitLine("}");
+
+        if (pgo)
+        {
+            closeIfChains(statementDepth + 1); // chains in the block above live inside this arm
+            chain = (!(ifChains.empty()) && ifChains.back().depth == statementDepth) ? &ifChains.back() : nullptr;
+            if (chain)
+                chain->arms.push_back(IfChain::Arm { armStart, emit.code.size(), condition, pgo->at(pgo->taken, line) });
+        }
+    }
+    else if (checkToken(TokenType::Token::IF)) // "IF" comparison "THEN" nl {statement} "ENDIF" nl
+    {
+        nextToken(); 
+        size_t armStart { emit.code.size() };
+        emit.emit("if (");             // comparison goes inside paranthesis
+        beginCondition(line);
+        size_t conditionStart { emit.code.size() };
+        comparison();                  // parse for comparison
+        std::string condition { emit.code.substr(conditionStart) };
+        endCondition();
+
+        match(TokenType::Token::THEN); // match for THEN token after comparison
+        nl();                          // check for valid newline leading to statements after THEN keyword
+        emit.emitLine(")" + branchHint(line, line));
+        emit.emitLine("{");
+
+        // zero or more statements before next ENDIF statement
+        while (!(checkToken(TokenType::Token::ENDIF)))
+        {
+            statement(); // parse all statements in THEN block before ENDIF
+        }
+
+        match(TokenType::Token::ENDIF); // match for ENDIF keyword when no more statements are found in THEN block
+        emit.emitLine("}");
+
+        if (pgo) // start a chain for the ELIFs that may follow
+        {
+            closeIfChains(statementDepth + 1); // chains in the block above live inside this arm
+            ifChains.push_back(IfChain { statementDepth, line, { IfChain::Arm { armStart, emit.code.size(), condition, pgo->at(pgo->taken, line) } } });
+        }
+
+        hasTrailingIf = true;
+    }
+    else if (checkToken(TokenType::Token::WHILE)) // "WHILE" comparison "REPEAT" nl {statement} "ENDWHILE" nl
+    {
+        nextToken();
+        emit.emit("while (");
+        beginCondition(line);
+        comparison();                    // parse for comparison then match for REPEAT keyword
+        endCondition();
+
+        match(TokenType::Token::REPEAT); // match for REPEAT keyword after comparison
+        nl();                            // newline after REPEAT keyword
+        emit.emitLine(")" + branchHint(line, line));
+        emit.emitLine("{");
+
+        while (!(checkToken(TokenType::Token::ENDWHILE))) // zero or more statements in while-loop body
+        {
+            statement();
+        }
+        match(TokenType::Token::ENDWHILE); // match for ENDWHILE after all statements in while-loop body
+        countLine(line);                   // back-edge
+        emit.emitLine("}");                // closing while loop block
+    }
+    else if (checkToken(TokenType::Token::FOR) && checkPeek(TokenType::Token::EACH)) // "FOR" "EACH" ident "IN" (array | "CALL" ident ["WITH" arguments]) {stage} "THEN" nl {statement} "ENDFOR" nl
+    {
+        nextToken();
+        nextToken();
+
+        std::string element { curToken.tokenText };
+        bool shadows { symbols.contains(element) }; // still there after the loop
+        bool shadowsSigned { signedInts.contains(element) };
+        bool shadowsUnsigned { unsignedInts.contains(element) };
+        match(TokenType::Token::IDENT);
+        match(TokenType::Token::IN);
+        if (!(checkToken(TokenType::Token::CALL)) && !(arrays.contains(curToken.tokenText)))
+            abort("Expected an array or CALL of a GENERATOR after IN, got: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        // signed or unsigned like the array's elements, until a MAP stage works out new values
+        bool elementSigned { signedInts.contains(curToken.tokenText) && !(checkToken(TokenType::Token::CALL)) };
+        bool elementUnsigned { unsignedInts.contains(curToken.tokenText) && !(checkToken(TokenType::Token::CALL)) };
+
+        // an array is walked with its iterators and a GENERATOR works out the next value every time around
+        size_t start { emit.code.size() };
+        if (checkToken(TokenType::Token::CALL))
+        {
+            primary();
+        }
+        else
+        {
+            noteRead(curToken.tokenText);
+            emit.emit(curToken.tokenText);
+            nextToken();
+        }
+        std::string values { emit.code.substr(start) };
+        emit.code.resize(start);
+
+        symbols.insert(element); // local to the loop, like a FOR identifier, and stands for the value in the stages
+        declareLocal(element);
+        eachElements.insert(element);
+        noteNumber(element, elementSigned ? "int" : elementUnsigned ? "std::uint64_t" : "");
+
+        // "WHERE" comparison | "MAP" expression | "TAKE" expression, in the order they're written. They go into the loop
+        // body as an IF, a new value and a counter, so every value goes through all of them before the next one is looked
+        // at, no arrays are made in between, and the C++ compiler sees a plain loop it can vectorize (std::views
+        // filter/transform pipelines came out 1.5 to 4x slower with GCC)
+        std::string counters {};  // TAKE counts, declared by the for
+        std::string stages {};    // start of the loop body
+        std::string takeChecks {}; // end of the loop body, so the value after the last one TAKEn isn't worked out
+        int blocks { 0 };
+        for (int stage { 0 }; checkToken(TokenType::Token::WHERE) || checkToken(TokenType::Token::MAP) || checkToken(TokenType::Token::TAKE); stage++)
+        {
+            TokenType::Token kind { static_cast<TokenType::Token>(curToken.tokenKind) };
+            nextToken();
+            start = emit.code.size();
+            if (kind == TokenType::Token::WHERE)
+                comparison();
+            else
+                expression();
+            std::string value { emit.code.substr(start) };
+            emit.code.resize(start);
+
+            std::string name { "nubb_each" + toString(stage) };
+            if (kind == TokenType::Token::WHERE)
+            {
+                stages += "if (" + value + ")\n{\n";
+                blocks++;
+            }
+            else if (kind == TokenType::Token::MAP) // the new value gets the old one's name in a block of its own
+            {
+                stages += "const auto& " + name + " { " + value + " };\n{\nconst auto& " + element + " { " + name + " };\n";
+                blocks++;
+                noteNumber(element, "");
+            }
+            else
+            {
+                counters += (counters.empty() ? "long long " : ", ") + name + " { " + value + " }";
+                stages += "if (" + name + "-- <= 0)\nbreak;\n";
+                takeChecks += "if (" + name + " <= 0)\nbreak;\n";
+            }
+        }
+
+        if (!(counters.empty()))
+            counters += "; ";
+        emit.emitLine("for (" + counters + "const auto& " + element + " : " + values + ")");
+        match(TokenType::Token::THEN);
+        nl();
+        emit.emitLine("{");
+        emit.emit(stages);
+
+        while (!(checkToken(TokenType::Token::ENDFOR)))
+        {
+            statement();
+        }
+
+        match(TokenType::Token::ENDFOR);
+        if (!(shadows))
+            symbols.erase(element);
+        eachElements.erase(element);
+        noteNumber(element, shadowsSigned ? "int" : shadowsUnsigned ? "std::uint64_t" : "");
+        for (int i { 0 }; i < blocks; i++)
+        {
+            emit.emitLine("}");
+        }
+        countLine(line);                // back-edge
+        emit.emit(takeChecks);
+        emit.emitLine("}");
+    }
+    else if (checkToken(TokenType::Token::YIELD)) // "YIELD" expression nl
+    {
+        if (!(generatorBody))
+            abort("YIELD can only be used in a GENERATOR on line " + toString(currentLine+1));
+        nextToken();
+
+        // the GENERATOR stops here until the FOR EACH wants the next value
+        emit.emit("co_yield ");
+        expression();
+        emit.emitLine(";");
+        yielded = true;
+    }
+    else if (checkToken(TokenType::Token::FOR)) // "FOR" ident ":" comparison ":" expression "THEN" nl {statement} "ENDFOR" nl
+    {
+        nextToken();
+        size_t loopStart { emit.code.size() }; // --bounds=hoist checks go in front of the loop
+        emit.emit("for (");
+
+        /*
+        
+        FOR statements do NOT allow global/static variables previously defined to be used. Everything must
+        be defined within the scope of the FOR statement. (Local variables is good practice anyways :P)
+
+        e.g. 'FOR a: a <= 10: a++ THEN' will not execute since no type can be found for the identifier.
+        You'd have to change it to something like 'FOR int a: a <= 10: a++' for the FOR statement to compile.
+
+        This can be fixed by creating a new Variable struct/class system where we verify types of variables, so that previously defined
+        variables can be recognized and evaluated properly (i.e. deemed legal/illegal for the FOR statement).
+        
+        */
+
+        // FOR loops only support integral identifiers, no string loops :P
+        // This emits the type of the iterator variable as C++, i8 to u64 have longer names there
+        std::string iteratorType { matchType() };
+        if (integerType(iteratorType) || (iteratorType == "float") || (iteratorType == "double"))
+        {
+            emit.emit(iteratorType + " " + curToken.tokenText + " {}; "); // iterator always starts at 0
+        }
+        else 
+        {
+            abort("Illegal use of type: \'" + iteratorType + "\' in FOR statement" + " on line " + toString(currentLine+1));
+        }
+
+        // temporarily add FOR statement identifier so parser can use local variable in FOR statement
+        // otherwise parser will freak out since it doesn't understand local scope
+        std::string localForIterator { curToken.tokenText };
+        symbols.insert(localForIterator);
+        noteNumber(localForIterator, iteratorType);
+        declareLocal(localForIterator); // declared by the C++ for
+        noteWrite(localForIterator); // a FOR inside a FOR can reuse the outer one's iterator
+            
+        nextToken();        // skip colon after init-statement/ident
+        nextToken();        // called twice to skip over ident then colon, which will then land on comparison
+
+        beginCondition(line);
+        size_t conditionStart { emit.code.size() };
+        forCondition = true;
+        comparison();
+        forCondition = false;
+        std::string condition { emit.code.substr(conditionStart) };
+        endCondition();
+        emit.emit(";");
+
+        nextToken();        // skip colon after comparison/condition
+
+        size_t stepStart { emit.code.size() };
+        expression();
+        std::string step { emit.code.substr(stepStart) };
+        emit.emitLine(")" + branchHint(line, line)); // close FOR statement after end-expression parsed
+
+        match(TokenType::Token::THEN); 
+        nl();               // match for newline when FOR statement is closed
+        emit.emitLine("{");
+
+        bool hoisting { boundsHoist && iteratorType == "int" && beginHoistLoop(line, localForIterator, condition, step, loopStart) };
+
+        // parse all statements until ENDFOR found
+        while (!(checkToken(TokenType::Token::ENDFOR)))
+        {
+            statement();
+        }
+
+        match(TokenType::Token::ENDFOR);    // match for ENDFOR after statements are parsed
+        symbols.erase(localForIterator);    // erase local FOR identifier 
+        signedInts.erase(localForIterator);
+        unsignedInts.erase(localForIterator);
+        if (hoisting)
+            endHoistLoop();
+        countLine(line);                    // back-edge
+        emit.emitLine("}");                 // close FOR statement
+    }
+    else if (checkToken(TokenType::Token::PARALLEL)) // "PARALLEL" "FOR" "int" ident ":" ident ("<" | "<=") expression ":" ident ("++" | "+=" expression) ["GRAIN" expression] ["REDUCE" ident ":" ("+" | "*") {"," ident ":" ("+" | "*")}] "THEN" nl {statement} "ENDFOR" nl
+    {
+        nextToken();
+        match(TokenType::Token::FOR);
+        size_t loopStart { emit.code.size() }; // --bounds=hoist checks go in front of the loop
+
+        if (!(checkToken(TokenType::Token::INT_T)))
+            abort("PARALLEL FOR needs an int iterator on line " + toString(currentLine+1));
+        nextToken();
+
+        std::string iterator { curToken.tokenText };
+        match(TokenType::Token::IDENT);
+        match(TokenType::Token::COLON);
+
+        // the pieces get emitted while they're parsed, then taken back out and put in their place in the call below
+        auto takeExpression = [&]()
+        {
+            size_t start { emit.code.size() };
+            expression();
+            std::string text { emit.code.substr(start) };
+            emit.code.resize(start);
+            return text;
+        };
+
+        if (curToken.tokenText != iterator || !(checkPeek(TokenType::Token::LT) || checkPeek(TokenType::Token::LTEQ)))
+            abort("PARALLEL FOR condition has to be '" + iterator + " < end' or '" + iterator + " <= end' on line " + toString(currentLine+1));
+        nextToken();
+        bool inclusive { checkToken(TokenType::Token::LTEQ) };
+        nextToken();
+
+        forCondition = true;
+        std::string end { takeExpression() };
+        forCondition = false;
+        if (end.find("&&") != std::string::npos || end.find("||") != std::string::npos)
+            abort("PARALLEL FOR condition has to be '" + iterator + " < end' or '" + iterator + " <= end' on line " + toString(currentLine+1));
+        match(TokenType::Token::COLON);
+
+        std::string step { "1" };
+        if (curToken.tokenText != iterator || !(checkPeek(TokenType::Token::PLUSPLUS) || checkPeek(TokenType::Token::PLUSEQ)))
+            abort("PARALLEL FOR step has to be '" + iterator + "++' or '" + iterator + " += step' on line " + toString(currentLine+1));
+        nextToken();
+        if (checkToken(TokenType::Token::PLUSEQ))
+        {
+            nextToken();
+            step = takeExpression();
+        }
+        else
+        {
+            nextToken();
+        }
+
+        std::string grain { "0" }; // the runtime picks one
+        if (checkToken(TokenType::Token::GRAIN))
+        {
+            nextToken();
+            grain = takeExpression();
+        }
+
+        std::vector<std::pair<std::string, char>> reductions {};
+        if (checkToken(TokenType::Token::REDUCE))
+        {
+            do
+            {
+                nextToken(); // skip REDUCE or comma
+                std::string name { curToken.tokenText };
+                if (!(symbols.contains(name)))
+                    abort("Cannot REDUCE undefined variable: " + name + " on line " + toString(currentLine+1));
+                noteWrite(name);
+                match(TokenType::Token::IDENT);
+                match(TokenType::Token::COLON);
+
+                if (checkToken(TokenType::Token::PLUS))
+                    reductions.push_back({ name, '+' });
+                else if (checkToken(TokenType::Token::ASTERISK))
+                    reductions.push_back({ name, '*' });
+                else
+                    abort("REDUCE operator has to be + or * on line " + toString(currentLine+1));
+                reduced.insert(name);
+                nextToken();
+            } while (checkToken(TokenType::Token::COMMA));
+        }
+
+        match(TokenType::Token::THEN);
+        nl();
+
+        // counters and the allocation/trace logs aren't thread safe, so instrumented programs run the loop on one thread
+        bool serial { profile || trace || pgoGenerate || allocProfile };
+        emit.emitLine(std::string("nubb_parallel::run") + (serial ? "<true>" : "") + "(" + toString(line) + ", static_cast<long long>(" + end + ")" +
+            (inclusive ? " + 1" : "") + ", " + step + ", " + grain + ", [&](long long nubb_first, long long nubb_last)");
+        emit.emitLine("{");
+
+        // every thread works on its own copy of a REDUCE variable, then adds it to the real one when its chunk is done
+        for (const auto& [name, op] : reductions)
+        {
+            emit.emitLine("auto& nubb_" + name + " { " + name + " };");
+        }
+        if (!(reductions.empty()))
+            emit.emitLine("{");
+        for (const auto& [name, op] : reductions)
+        {
+            emit.emitLine("auto " + name + " { nubb_parallel::identity<'" + std::string(1, op) + "'>(nubb_" + name + ") };");
+        }
+
+        emit.emitLine("for (int " + iterator + " { static_cast<int>(nubb_first) }; " + iterator + " < nubb_last; " + iterator + " += " + step + ")");
+        emit.emitLine("{");
+
+        symbols.insert(iterator);
+        noteNumber(iterator, "int");
+        noteWrite(iterator); // before the body, where it's the only thing that can be written
+        bool hoisting { boundsHoist && beginHoistLoop(line, iterator, iterator + (inclusive ? "<=" : "<") + end, iterator + (step == "1" ? "++" : "+=" + step), loopStart) };
+
+        parallelBody = true;
+        parallelLocals.insert(iterator);
+        while (!(checkToken(TokenType::Token::ENDFOR)))
+        {
+            statement();
+        }
+        parallelBody = false;
+        parallelLocals = NameSet {};
+        reduced = NameSet {};
+
+        match(TokenType::Token::ENDFOR);
+        symbols.erase(iterator);
+        signedInts.erase(iterator);
+        if (hoisting)
+            endHoistLoop();
+        countLine(line); // back-edge
+        emit.emitLine("}");
+
+        for (const auto& [name, op] : reductions)
+        {
+            emit.emitLine("nubb_parallel::combine<'" + std::string(1, op) + "'>(nubb_" + name + ", " + name + ");");
+        }
+        if (!(reductions.empty()))
+            emit.emitLine("}");
+        emit.emitLine("});");
+
+        runtimeUsed.insert("parallel");
+    }
+    else if (checkToken(TokenType::Token::FOREACH)) // "FOREACH" "LINE" ident "IN" (string | ident) "THEN" nl {statement} "ENDFOREACH" nl
+    {
+        nextToken();
+        match(TokenType::Token::LINE);
+
+        std::string lineVariable { curToken.tokenText };
+        match(TokenType::Token::IDENT);
+        match(TokenType::Token::IN);
+
+        // every line is a view into the memory mapped file, so nothing is copied until LET stores it in a string
+        emit.emitLine("for (std::string_view " + lineVariable + " : nubb_file::Lines { " + filePath() + " })");
+
+        match(TokenType::Token::THEN);
+        nl();
+        emit.emitLine("{");
+
+        symbols.insert(lineVariable); // local to the loop, like a FOR identifier
+        declareLocal(lineVariable);
+        noteWrite(lineVariable);
+        while (!(checkToken(TokenType::Token::ENDFOREACH)))
+        {
+            statement();
+        }
+
+        match(TokenType::Token::ENDFOREACH);
+        symbols.erase(lineVariable);
+        countLine(line);                // back-edge
+        emit.emitLine("}");
+
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("file");
+    }
+    else if (checkToken(TokenType::Token::WRITE)) // "WRITE" (string | ident) ":" (expression | string) nl
+    {
+        nextToken();
+        emit.emit("nubb_file::writer(" + filePath() + ").line(");
+        match(TokenType::Token::COLON);
+
+        if (checkToken(TokenType::Token::STRING)) // written like PRINT, one value per line
+        {
+            emit.emit("\"" + curToken.tokenText + "\"");
+            nextToken();
+        }
+        else
+        {
+            expression();
+        }
+        emit.emitLine(");");
+
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("file");
+    }
+    else if (checkToken(TokenType::Token::LABEL)) // "LABEL" ident nl
+    {
+        nextToken();
+
+        if (labelsDeclared.contains(curToken.tokenText)) // ensure LABEL given doesn't exist to prevent redefiniton, otherwise add to set
+        {
+            abort("Redefinition of label: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        }
+        labelsDeclared.insert(curToken.tokenText);
+
+        emit.emitLine(curToken.tokenText + ":"); 
+        match(TokenType::Token::IDENT);          // match for identifier after LABEL
+    }
+    else if (checkToken(TokenType::Token::GOTO)) // "GOTO" ident nl
+    {
+        nextToken();
+        labelsGotoed.insert(curToken.tokenText); // add LABEL identifier that has been gotoed
+        
+        emit.emitLine("goto " + curToken.tokenText + ';');
+        match(TokenType::Token::IDENT);          // match for identifier after GOTO
+    }
+    else if (checkToken(TokenType::Token::LET)) // "LET" type ident "=" expression nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText))) // if we see an undefined variable in LET statement
+        {
+            std::string var_type { matchType() }; // save type from matchType to initialize variables properly, mainly arrays and normal integral/string variables
+            bool isArray { var_type.starts_with("std::vector") || var_type.starts_with("std::array") || var_type.starts_with("nubb_bits") };
+            bool isMap { var_type.starts_with("nubb_map") };
+            bool isMatrix { var_type.starts_with("nubb_matrix") };
+            bool countedArray { allocProfile && var_type.starts_with("std::vector") }; // std::array never allocates
+            int value { lex.lookAhead(1).tokenKind }; // first token after the "="
+            declareLocal(curToken.tokenText);
+            bool fromValue { (isArray || isMatrix) && (value == TokenType::Token::CALL || value == TokenType::Token::MOVE ||
+                (value >= TokenType::Token::TRANSPOSE && value <= TokenType::Token::COLSUM)) }; // whole array, not a list of values
+            bool elementwiseValue { isArray && !(fromValue) && elementwiseAhead() }; // 'a + b * 2' on every element
+
+            if (isArray)
+                arrays.insert(curToken.tokenText);
+            else
+                arrays.erase(curToken.tokenText);
+            if (isMap)
+                maps.insert(curToken.tokenText);
+            else
+                maps.erase(curToken.tokenText);
+            if (isMatrix)
+                matrices.insert(curToken.tokenText);
+            else
+                matrices.erase(curToken.tokenText);
+            noteNumber(curToken.tokenText, var_type);
+
+            if (elementwiseValue) // one loop filling the new array, see elementwiseExpression()
+            {
+                symbols.insert(curToken.tokenText);
+                bool typed { var_type != "std::vector" && !(countedArray) }; // untyped arrays get the type of the elements
+                emit.emit((typed ? var_type : "auto") + " " + curToken.tokenText + " { nubb_array::map" + (typed ? "<" + var_type + ">" : "") + "(");
+                if (var_type.starts_with("std::array"))
+                    fixedArrays.insert(curToken.tokenText);
+                countedArray = false;
+            }
+            else if (fromValue && (countedArray || var_type == "std::vector")) // takes the type (and counting) of what it's given
+            {
+                symbols.insert(curToken.tokenText);
+                emit.emit("auto " + curToken.tokenText + " { ");
+                countedArray = false;
+            }
+            else if (countedArray && var_type == "std::vector") // counted array, element type comes from the values
+            {
+                symbols.insert(curToken.tokenText);
+                emit.emit("auto " + curToken.tokenText + " { nubb_alloc::array(" + toString(line) + ", { ");
+            }
+            else if (countedArray) // counted array<type>
+            {
+                symbols.insert(curToken.tokenText);
+                emit.emit("auto " + curToken.tokenText + " { nubb_alloc::array<" + var_type.substr(12, var_type.size() - 13) + ">(" + toString(line) + ", { ");
+            }
+            else if (allocProfile && var_type == "std::string") // counted string
+            {
+                symbols.insert(curToken.tokenText);
+                emit.emit("nubb_alloc::String " + curToken.tokenText + " { " + toString(line) + ", ");
+            }
+            else if (!(isArray))
+            {
+                emit.emit(var_type); // emit type of declared variable if NOT an array (using type deduction in C++ for std::vector, no explicit types)
+                symbols.insert(curToken.tokenText);          // add undefined variable to set after fetching type
+                emit.emit(" " + curToken.tokenText + " { "); // variable declaration with static type
+            }
+            else
+            {
+                symbols.insert(curToken.tokenText);          // add undefined variable to set after fetching type
+                emit.emit(var_type + " " + curToken.tokenText + " { "); // std::vector, std::vector<type> or std::array<type, size>
+                if (var_type.starts_with("std::array"))
+                    fixedArrays.insert(curToken.tokenText);
+            }
+
+            match(TokenType::Token::IDENT); // match for identifier after LET keyword
+
+            /*
+            
+            Nubb++ only checks numbers during parsing (see checkNumber() and expression()). So statements like 
+            LET bool b = "text" CAN get through but WILL CRASH when trying to compile since this syntactically makes
+            no sense and is invalid per C++ rules.
+            
+            */
+
+            // i8 to u64 take whatever they're given and wrap it around to fit, instead of C++ complaining about narrowing
+            std::string element { numberElement(var_type) };
+            std::string convert {};
+            if (integerType(element) && element != "int")
+                convert = "static_cast<" + element + ">(";
+
+            match(TokenType::Token::EQ);   // then match for EQ sign 
+            if (elementwiseValue)
+            {
+                emit.emit(elementwiseExpression(line) + ")");
+            }
+            else if (fromValue || (isMap && (value == TokenType::Token::CALL || value == TokenType::Token::MOVE))) // returned by a function or moved from another array, never copied
+            {
+                expression();
+            }
+            else if (isMatrix) // rows, columns, every element starts out 0
+            {
+                emit.emit(toString(line) + ", ");
+                expression();
+                match(TokenType::Token::COMMA);
+                emit.emit(", ");
+                expression();
+            }
+            else if (isMap) // key: value pairs, can start out empty
+            {
+                while (curToken.tokenKind != TokenType::Token::NEWLINE)
+                {
+                    emit.emit("{ " + mapKey() + ", ");
+                    match(TokenType::Token::COLON);
+                    expression();
+                    match(TokenType::Token::COMMA);
+                    emit.emit(" },");
+                }
+            }
+            else if (isArray) // handle array initialization, a typed array can start out empty
+            {
+                while (curToken.tokenKind != TokenType::Token::NEWLINE) // until a newline character is reached
+                {
+                    checkNumber(element);
+                    emit.emit(convert);
+                    expression();                   // get variables/literals to be added into array
+                    if (!(convert.empty()))
+                        emit.emit(")");
+                    match(TokenType::Token::COMMA); // match comma after every expression
+                    emit.emit(","); 
+                }
+            }
+            else
+            {
+                checkNumber(element);
+                emit.emit(convert);
+                expression(); // then parse for expression, will return variable value
+                if (!(convert.empty()))
+                    emit.emit(")");
+            }
+
+            if (countedArray)
+                emit.emitLine(" }) };");
+            else
+                emit.emitLine(" };"); 
+        }
+        else
+        {
+
+            /*
+            
+            Slight vulnerability here with arrays and functions. You can manipulate them with an expression like 'arr = 4'
+            and it will compile, however, this will obviously not run with g++. So for the time being (and unless asked),
+            I'll just leave this as is.
+
+            If you wanna add/remove stuff in arrays, do so with the ADD/POP statements.
+            As for functions, why even do something like this. Please be wary of redefinition ya nerds.
+            
+            */
+
+            std::string name { curToken.tokenText };
+            int value { lex.lookAhead(1).tokenKind }; // first token after the "="
+            bool element { matrices.contains(name) && checkPeek(TokenType::Token::COLON) }; // "LET" matrix ":" index ":" index "=" expression nl
+            bool elementwiseValue { arrays.contains(name) && value != TokenType::Token::CALL && value != TokenType::Token::MOVE && elementwiseAhead() };
+            noteWrite(name);
+
+            match(TokenType::Token::IDENT); // match for identifier after LET keyword
+            std::string target { name };
+            if (element)
+                target = matrixIndex(name);
+            match(TokenType::Token::EQ);    // then match for EQ sign 
+
+            if (elementwiseValue) // straight into the array's own storage, which can be in the expression too
+            {
+                emit.emitLine("nubb_array::assign(" + name + ", " + elementwiseExpression(line) + ");");
+            }
+            else
+            {
+                emit.emit(target + " = "); // known variable, reference without auto keyword
+                expression(); // then parse for expression, will return variable value
+                emit.emitLine(";");
+            }
+        }
+    }
+    else if (checkToken(TokenType::Token::CONST)) // "CONST" type ident "=" expression nl
+    {
+        nextToken();
+
+        std::string constType { matchType() };
+        if (constType == "std::string") // points into the program's data, a std::string would be built at runtime
+            constType = "std::string_view";
+        else if (constType.starts_with("std::vector") || constType.starts_with("nubb_bits"))
+            abort("CONST array needs a size, e.g. array<int, 4> on line " + toString(currentLine+1));
+        else if (constType.starts_with("nubb_map") || constType.starts_with("nubb_matrix"))
+            abort("A map or matrix can't be CONST on line " + toString(currentLine+1));
+
+        std::string name { curToken.tokenText };
+        if (symbols.contains(name))
+            abort("Redefinition of CONST: " + name + " on line " + toString(currentLine+1));
+
+        match(TokenType::Token::IDENT);
+        match(TokenType::Token::EQ);
+
+        // the C++ compiler works the value out, so nothing is left to do when the program starts
+        emit.emit("constexpr " + constType + " " + name + " { ");
+        constantValue = true;
+        std::string element { numberElement(constType) }; // numbers are checked and converted like LET does
+        std::string convert {};
+        if (integerType(element) && element != "int")
+            convert = "static_cast<" + element + ">(";
+        if (constType.starts_with("std::array"))
+        {
+            while (curToken.tokenKind != TokenType::Token::NEWLINE) // same value list as LET
+            {
+                checkNumber(element);
+                emit.emit(convert);
+                expression();
+                if (!(convert.empty()))
+                    emit.emit(")");
+                match(TokenType::Token::COMMA);
+                emit.emit(",");
+            }
+            fixedArrays.insert(name);
+            arrays.insert(name);
+        }
+        else
+        {
+            checkNumber(element);
+            emit.emit(convert);
+            expression();
+            if (!(convert.empty()))
+                emit.emit(")");
+        }
+        constantValue = false;
+        emit.emitLine(" };");
+
+        symbols.insert(name); // only now, a CONST can't use itself
+        constants.insert(name);
+        noteNumber(name, constType);
+    }
+    else if (checkToken(TokenType::Token::SORT)) // "SORT" array nl
+    {
+        nextToken();
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot SORT undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteWrite(curToken.tokenText);
+
+        emit.emitLine("nubb_algo::sort(" + curToken.tokenText + ");"); // smallest first
+        match(TokenType::Token::IDENT);
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("algorithm");
+    }
+    else if (checkToken(TokenType::Token::INSERT)) // "INSERT" map ":" key ":" expression nl
+    {
+        nextToken();
+        if (!(maps.contains(curToken.tokenText)))
+            abort("Cannot INSERT into something that isn't a map: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteWrite(curToken.tokenText);
+
+        std::string map { curToken.tokenText };
+        nextToken();
+        match(TokenType::Token::COLON);
+        emit.emit(map + ".insert(" + mapKey() + ", "); // replaces the value if the key is there already
+        match(TokenType::Token::COLON);
+        expression();
+        emit.emitLine(");");
+    }
+    else if (checkToken(TokenType::Token::ERASE)) // "ERASE" map ":" key nl
+    {
+        nextToken();
+        if (!(maps.contains(curToken.tokenText)))
+            abort("Cannot ERASE from something that isn't a map: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        noteWrite(curToken.tokenText);
+
+        std::string map { curToken.tokenText };
+        nextToken();
+        match(TokenType::Token::COLON);
+        emit.emitLine(map + ".erase(" + mapKey() + ");"); // nothing happens if the key isn't there
+    }
+    else if (checkToken(TokenType::Token::CAST)) // "CAST" ident ":" type nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText))) // identifier to cast isn't defined
+            abort("Cannot cast undefined variable: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        std::string cast_ident { curToken.tokenText }; // save cast identifier to check validity later
+        
+        nextToken();                                   // continue parsing since we've verified there is an identifier to cast
+        match(TokenType::Token::COLON);                // match for colon before type
+        
+        emit.emit("static_cast<");
+        std::string cast_type { matchType() };         // get type to cast identifier to
+
+        if (cast_type == "auto") // cannot use 'auto' for type casting
+            abort("Cannot cast variable to type 'auto' on line " + toString(currentLine+1));
+
+        emit.emitLine(cast_type + ">(" + cast_ident + ");"); // emit rest of CAST statement
+
+    }
+    else if (checkToken(TokenType::Token::INPUT)) // "INPUT" (type ident | ident)  nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+        {   
+            /* 
+             * Nubb++ has requires static type after INPUT statement. If not provided,
+             * parsing will abort.
+             */
+            
+            if (curToken.tokenText == "auto") // attempting to use auto type on uninitialized variable declaration
+            {
+                nextToken(); // nextToken() to return variable in question to user so they can debug their dumb mistake
+                abort("Cannot use variable of type 'auto' in INPUT: " + curToken.tokenText + " on line " + toString(currentLine+1));
+            }
+
+            std::string inputType { matchType() };
+            if (allocProfile && inputType == "std::string") // counted string
+                emit.headerLine("nubb_alloc::String " + curToken.tokenText + " { " + toString(line) + " };");
+            else
+                emit.headerLine(inputType + " " + curToken.tokenText + " {};"); // emit input variable at header of source
+            symbols.insert(curToken.tokenText);
+            noteNumber(curToken.tokenText, inputType);
+        }
+        noteWrite(curToken.tokenText);
+
+        // the runtime reader validates input itself and skips the rest of the line when it's invalid,
+        // and flushes PRINT output before it waits on stdin
+        emit.emitLine("\tnubb_io::in.read(" + curToken.tokenText + ");");
+        runtimeUsed.insert("print");
+        runtimeUsed.insert("input");
+
+        match(TokenType::Token::IDENT); // match for identifier after INPUT keyword
+    }
+    else if (checkToken(TokenType::Token::ADD_ARRAY)) // "ADD" array ":" expression nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot add element to undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        if (fixedArrays.contains(curToken.tokenText))
+            abort("Cannot add element to fixed-size array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        emit.emit(curToken.tokenText + ".push_back(");
+        noteWrite(curToken.tokenText);
+
+        nextToken();
+        match(TokenType::Token::COLON);
+        expression();
+
+        emit.emitLine(");");
+    }
+    else if (checkToken(TokenType::Token::POP_ARRAY)) // "POP" array nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot pop element from undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        if (fixedArrays.contains(curToken.tokenText))
+            abort("Cannot pop element from fixed-size array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        emit.emitLine(curToken.tokenText + ".pop_back();");
+        noteWrite(curToken.tokenText);
+        nextToken();
+    }
+    else if (checkToken(TokenType::Token::RESERVE)) // "RESERVE" array ":" expression nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+            abort("Cannot reserve space in undefined array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        if (fixedArrays.contains(curToken.tokenText))
+            abort("Cannot reserve space in fixed-size array: " + curToken.tokenText + " on line " + toString(currentLine+1));
+
+        // room for that many elements up front, so ADDs up to it never reallocate
+        emit.emit(curToken.tokenText + ".reserve(");
+        noteWrite(curToken.tokenText);
+
+        nextToken();
+        match(TokenType::Token::COLON);
+        expression();
+
+        emit.emitLine(");");
+    }
+    else if (checkToken(TokenType::Token::CALL)) // "CALL" ident nl
+    {
+        nextToken();
+
+        if (!(symbols.contains(curToken.tokenText)))
+        {
+            abort("Cannot call an undefined function on line " + toString(currentLine+1));
+        }
+        noteCall(curToken.tokenText);
+
+        emit.emit(curToken.tokenText + "(");
+        match(TokenType::Token::IDENT);
+        arguments();
+        emit.emitLine(");");
+
+    }
+    else if (checkToken(TokenType::Token::BENCH)) // "BENCH" ident "ITER" expression "THEN" nl {statement} "ENDBENCH" nl
+    {
+        nextToken();
+        std::string benchName { curToken.tokenText };
+        match(TokenType::Token::IDENT); // benchmarks get a name, not a variable
+        match(TokenType::Token::ITER);
+
+        // the body becomes a lambda so the harness can call it once per timed iteration
+        emit.emit("nubb_bench::run(\"" + benchName + "\", ");
+        expression();
+        emit.emitLine(", [&]()");
+        emit.emitLine("{");
+
+        match(TokenType::Token::THEN);
+        nl();
+
+        while (!(checkToken(TokenType::Token::ENDBENCH))) // zero or more statements in benchmark body
+        {
+            statement();
+        }
+        match(TokenType::Token::ENDBENCH);
+        emit.emitLine("});");
+
+        runtimeUsed.insert("bench");
+    }
+    else if (checkToken(TokenType::Token::FUNCTION) || checkToken(TokenType::Token::PURE) || checkToken(TokenType::Token::GENERATOR)) // ["PURE" | "GENERATOR"] "FUNCTION" ["VOID" | type] ident ["WITH" parameters] ":" nl {statement} ["RETURN" expression] "ENDFUNCTION" nl
+    {
+        /*
+        
+        Slight vulnerabilities here.
+        RETURN parsing does not check for the variable scope, since once again, I haven't implemented a more sophisticated 
+        variable declaration system to check for such things.
+
+        Because of that, there is the possibility to have variable in other scopes outside of the function body to get past the RETURN
+        statement, which will break the C++ code and create errors in machine code compilation.
+        
+        Functions have a return type of 'auto' once compiled because managing variable stuff and things like that would be a PAIN.
+        
+        */
+
+        bool isVoidSpecified { false }; // announce that function is of void type
+        bool isPure { checkToken(TokenType::Token::PURE) }; // constexpr function, checked to only work out its result
+        bool isGenerator { checkToken(TokenType::Token::GENERATOR) }; // coroutine handing out values with YIELD
+        std::string yieldType {};
+        functionCount++;
+
+        if (isPure || isGenerator)
+        {
+            std::string kind { curToken.tokenText };
+            nextToken();
+            if (!(checkToken(TokenType::Token::FUNCTION)))
+                abort("Expected FUNCTION after " + kind + " on line " + toString(currentLine+1));
+        }
+
+        nextToken();
+        if (checkToken(TokenType::Token::VOID_SPECIFIER)) // function of void type given
+        {
+            if (isPure)
+                abort("PURE function has to RETURN a value on line " + toString(currentLine+1));
+
+            nextToken();
+            isVoidSpecified = true;
+        }
+        else if (isGenerator)
+        {
+            yieldType = matchType();
+            if (yieldType == "auto" || yieldType == "std::vector")
+                abort("GENERATOR needs the type of the values it YIELDs, got: " + yieldType + " on line " + toString(currentLine+1));
+        }
+
+        if (enteredFunctionBody)
+            abort("Cannot nest functions in function: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        
+        if(!(symbols.contains(curToken.tokenText))) // function identifier not declared yet
+        {
+            std::string name { curToken.tokenText };
+            symbols.insert(name);
+            if (isPure)
+                constants.insert(name);
+
+            match(TokenType::Token::IDENT);
+            pureBody = isPure;
+            generatorBody = isGenerator;
+            std::string list { parameters() };
+
+            // emit function identifier and create function body
+            if (name == "main")
+            {
+                if (!(list.empty()))
+                    abort("Function main cannot take parameters on line " + toString(currentLine+1));
+                if (isPure || isGenerator)
+                    abort("Function main cannot be PURE or a GENERATOR on line " + toString(currentLine+1));
+
+                // main function gets special declaration cuz it's the main C++ function
+                emit.emitLine("int main()");
+                emit.emitLine("{");
+            }
+            else if (isVoidSpecified)
+            {
+                emit.emitLine((pgo ? pgo->functionHint(line) : "") + "void " + name + "(" + list + ")");
+                emit.emitLine("{");
+            }
+            else if (isGenerator)
+            {
+                emit.emitLine((pgo ? pgo->functionHint(line) : "") + "nubb_gen::Generator<" + yieldType + "> " + name + "(" + list + ")");
+                emit.emitLine("{");
+                runtimeUsed.insert("generator");
+            }
+            else
+            {
+                emit.emitLine((pgo ? pgo->functionHint(line) : "") + (isPure ? "constexpr auto " : "auto ") + name + "(" + list + ")");
+                emit.emitLine("{");
+            }
+
+            if (isPure) // the body may run inside the C++ compiler, which has nothing to count or trace
+            {
+                instrumented = { profile, trace, pgoGenerate, allocProfile };
+                profile = trace = pgoGenerate = allocProfile = false;
+            }
+
+            if (profile) // count calls and time them, a GENERATOR's time is spread over the loop using it so only its calls count
+            {
+                countLine(line);
+                if (!(isGenerator))
+                    emit.emitLine("nubb_profile::Timer nubb_profile_timer { " + toString(line) + " };");
+            }
+            if (pgoGenerate)
+            {
+                emit.emitLine("++nubb_pgo::calls[" + toString(line) + "];");
+                countedLines = std::max(countedLines, line + 1);
+            }
+            if (trace && !(isGenerator)) // entry and exit of the call go into the timeline
+                emit.emitLine("nubb_trace::Scope nubb_trace_scope { \"" + name + "\" };");
+
+            match(TokenType::Token::COLON);
+        }
+        else // redefintiton of funtion identifier somewhere else in source
+        {
+            abort("Redefinition of function identifier: " + curToken.tokenText + " on line " + toString(currentLine+1));
+        }
+
+        nl();
+
+        if (!(isVoidSpecified) && !(isGenerator)) // normal 'auto' return type parsing
+        {
+            while (!(checkToken(TokenType::Token::RETURN)))
+            {
+                // until function body reaches return statement, parse statements
+                enteredFunctionBody = true;
+                statement();
+            }
+
+            match(TokenType::Token::RETURN);
+            emit.emit("return ");
+
+            // A local array or string comes back through NRVO (or moved), and a parameter is only copied
+            // when it has to be since it's const
+            expression();
+            emit.emit(";\n"); // Newline before closing bracket, otherwise things look stupid
+            if (checkToken(TokenType::Token::NEWLINE)) // ENDFUNCTION can go on the same line
+                nextToken();
+            match(TokenType::Token::ENDFUNCTION);
+        }
+        else // 'void' type returning, or a GENERATOR that's done when it gets to the end
+        {
+            while(!(checkToken(TokenType::Token::ENDFUNCTION)))
+            {
+                statement();
+            }
+            match(TokenType::Token::ENDFUNCTION);
+        }
+
+        if (isGenerator && !(yielded))
+            abort("GENERATOR has to YIELD at least one value on line " + toString(currentLine+1));
+        generatorBody = false;
+        yielded = false;
+        
+        emit.emitLine("}");
+        enteredFunctionBody = false;
+
+        for (const std::string& parameter : functionParameters)
+        {
+            symbols.erase(parameter);
+            arrays.erase(parameter);
+            maps.erase(parameter);
+            matrices.erase(parameter);
+            signedInts.erase(parameter);
+            unsignedInts.erase(parameter);
+        }
+        functionParameters.clear();
+        readOnly = NameSet {};
+
+        if (isPure)
+        {
+            std::tie(profile, trace, pgoGenerate, allocProfile) = instrumented;
+            pureBody = false;
+            pureLocals = NameSet {};
+        }
+    }
+    else // invalid staement occured somehow, effectively a syntax error
+    {
+        abort("Invalid statement at: " + curToken.tokenText + " on line " + toString(currentLine+1));
+    }
+
+    statementDepth--;
+    nl(); // output newline
+}
+
+// parse program source, program ::= {statement}
+constexpr void Parser::program()
+{
+    prologue();
+    body();
+    epilogue();
+}
+
+// Emit basic includes to header before any statements are parsed
+constexpr void Parser::prologue()
+{
+    if (log)
+        *log << "[INFO] PROGRAM: Prepping C++ source...\n";
+
+    // start appending basic includes and main() function to header
+    emit.headerLine("// Thank you for using Nubb++ ❤️");
+    emit.headerLine("#include <iostream>");
+    emit.headerLine("#include <string>");   // for string variable usage with static types as of Nubb++ 1.4
+    emit.headerLine("#include <string_view>"); // CONST strings as of Nubb++ 4.0
+    emit.headerLine("#include <utility>");  // std::move for MOVE as of Nubb++ 4.0
+    emit.headerLine("#include <array>");    // for fixed-size arrays as of Nubb++ 4.0
+    emit.headerLine("#include <cstdint>");  // i8 to u64 as of Nubb++ 4.0
+    emit.headerLine("#include <vector>\n");   // for array/vector usage as of Nubb++ 2.0
+
+    if (allocProfile) // before anything is declared, INPUT variables go in the header too
+    {
+        emit.headerLine("namespace nubb_alloc");
+        emit.headerLine("{");
+        emit.headerLine("    constexpr const char* source { " + cppString(profileSource) + " };");
+        emit.headerLine("}");
+        emit.headerLine(runtime::alloc);
+    }
+
+    if (log)
+        *log << "[INFO] PROGRAM: Finished prepping C++ source.\n";
+}
+
+// Parse all statements until EOF, also used by ParallelParser workers on their own chunk of source
+constexpr void Parser::body()
+{
+    // skip ALL newlines at the beginning of source file until valid token/statement/keyword is reached
+    // this will let us have comments at the root of our files now
+    while (checkToken(TokenType::Token::NEWLINE))
+    {
+        nextToken();
+        currentLine++;
+    }
+
+    // parse all statements in program until EOF is reached
+    while (!(checkToken(TokenType::Token::ENDOFFILE)))
+    {
+        statement();
+        currentLine++;
+    }
+    closeIfChains(0);
+}
+
+// Check for undefined labels once every statement is parsed
+constexpr void Parser::epilogue()
+{
+    if (log)
+        *log << "[INFO] PROGRAM: main() closed. Checking for undefined LABELS...\n";
+
+    // When parsing is finished, check for undefined labels
+    for (const auto& itr : labelsGotoed.sorted()) // sorted so the same label gets reported every time
+    {
+        if (!(labelsDeclared.contains(itr)))
+        {
+            abort("Attempting to GOTO an undefined label: " + itr);
+        }
+    }
+
+    // counters are sized by the last counted line, so they can only be declared now
+    for (std::string_view counters : { profile ? "nubb_profile" : "", pgoGenerate ? "nubb_pgo" : "" })
+    {
+        if (counters.empty())
+            continue;
+
+        emit.headerLine("namespace " + std::string(counters));
+        emit.headerLine("{");
+        emit.headerLine("    constexpr int lines { " + toString(std::max(countedLines, 1)) + " };");
+        emit.headerLine("    constexpr const char* source { " + cppString(profileSource) + " };");
+        emit.headerLine("}");
+        emit.headerLine(counters == "nubb_profile" ? runtime::profile : runtime::pgo);
+    }
+    if (trace)
+        emit.headerLine(runtime::trace);
+    if (runtimeUsed.contains("print") || runtimeUsed.contains("bench")) // BENCH prints its results too
+        emit.headerLine(runtime::print);
+    if (runtimeUsed.contains("bench"))
+        emit.headerLine(runtime::bench);
+    if (runtimeUsed.contains("input"))
+        emit.headerLine(runtime::input);
+    if (runtimeUsed.contains("file"))
+        emit.headerLine(runtime::file);
+    if (runtimeUsed.contains("bounds"))
+        emit.headerLine(runtime::bounds);
+    if (runtimeUsed.contains("parallel"))
+        emit.headerLine(runtime::parallel);
+    if (runtimeUsed.contains("bits"))
+        emit.headerLine(runtime::bits);
+    if (runtimeUsed.contains("algorithm"))
+        emit.headerLine(runtime::algorithm);
+    if (runtimeUsed.contains("elementwise"))
+        emit.headerLine(runtime::elementwise);
+    if (runtimeUsed.contains("map"))
+        emit.headerLine(runtime::map);
+    if (runtimeUsed.contains("generator"))
+        emit.headerLine(runtime::generator);
+    if (runtimeUsed.contains("matrix"))
+        emit.headerLine(runtime::matrix);
+
+    if (log)
+        *log << "[INFO] PROGRAM: Parsing complete. Pushing to Emitter...\n";
+}
+
+// Initalizes peekToken and curToken 
+constexpr void Parser::init()
+{
+    nextToken();
+    nextToken();
+
+    if (log)
+        *log << "[INFO] PARSER: Parser initialized. Parsing starting...\n";
+}
+
 #endif
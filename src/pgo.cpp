@@ -0,0 +1,48 @@
+#include "pgo.h"
+
+#include <sstream> // parses profile lines
+
+// Read the text of nubb_pgo.txt, lines that aren't 'branch <line> <evaluated> <taken>' or 'call <line> <count>' are skipped
+PgoProfile PgoProfile::parse(std::string_view text)
+{
+    PgoProfile profile {};
+    std::istringstream lines { std::string(text) };
+    std::string lineContent;
+
+    // make room for line in every list of counts
+    auto fit = [&profile](int line)
+    {
+        if (static_cast<size_t>(line) >= profile.evaluated.size())
+        {
+            profile.evaluated.resize(line + 1);
+            profile.taken.resize(line + 1);
+            profile.calls.resize(line + 1);
+        }
+    };
+
+    while (std::getline(lines, lineContent))
+    {
+        std::istringstream fields { lineContent };
+        std::string kind {};
+        int line {};
+        unsigned long long first {};
+        unsigned long long second {};
+
+        fields >> kind >> line >> first;
+        if (!(fields) || line < 0)
+            continue;
+
+        if (kind == "branch" && fields >> second)
+        {
+            fit(line);
+            profile.evaluated[line] = first;
+            profile.taken[line] = second;
+        }
+        else if (kind == "call")
+        {
+            fit(line);
+            profile.calls[line] = first;
+        }
+    }
+    return profile;
+}
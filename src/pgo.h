@@ -0,0 +1,65 @@
+#ifndef PGO_H
+#define PGO_H
+
+#include <string>      // for std::string
+#include <string_view> // for std::string_view
+#include <vector>      // for std::vector
+
+// Counts written by a program compiled with --pgo-gen (nubb_pgo.txt), read back by --pgo-use.
+// Everything is indexed by the source line of the IF/ELIF/WHILE/FOR or FUNCTION it counts, so the profile only
+// lines up with the source it was recorded from.
+struct PgoProfile
+{
+    std::vector<unsigned long long> evaluated {}; // Times the condition on a line was checked
+    std::vector<unsigned long long> taken {};     // Times it was true
+    std::vector<unsigned long long> calls {};     // Calls of the FUNCTION declared on a line
+
+    static constexpr unsigned long long minSamples { 32 }; // Fewer runs than this aren't worth a hint
+
+    constexpr bool empty() const { return evaluated.empty() && calls.empty(); }
+    constexpr unsigned long long at(const std::vector<unsigned long long>& counts, int line) const;
+    constexpr std::string branchHint(unsigned long long hits, unsigned long long total) const;
+    constexpr std::string functionHint(int line) const;
+
+    static PgoProfile parse(std::string_view text);
+};
+
+// Count for line, 0 when the profile has nothing for it
+constexpr unsigned long long PgoProfile::at(const std::vector<unsigned long long>& counts, int line) const
+{
+    return (line >= 0 && static_cast<size_t>(line) < counts.size()) ? counts[line] : 0;
+}
+
+// C++20 attribute for a branch taken hits times out of total, empty when it's not lopsided enough to matter
+constexpr std::string PgoProfile::branchHint(unsigned long long hits, unsigned long long total) const
+{
+    if (total < minSamples)
+        return "";
+    if (hits * 10 >= total * 9) // taken at least 90% of the time
+        return " [[likely]]";
+    if (hits * 10 <= total) // taken at most 10% of the time
+        return " [[unlikely]]";
+    return "";
+}
+
+// GCC attributes for the FUNCTION declared on line: never called means cold, a big share of all calls means hot
+constexpr std::string PgoProfile::functionHint(int line) const
+{
+    if (empty())
+        return "";
+
+    unsigned long long totalCalls {};
+    for (unsigned long long count : calls)
+    {
+        totalCalls += count;
+    }
+
+    unsigned long long count { at(calls, line) };
+    if (count == 0)
+        return "[[gnu::cold]] ";
+    if (count >= minSamples && count * 20 >= totalCalls) // at least 5% of every call made
+        return "[[gnu::hot]] inline ";
+    return "";
+}
+
+#endif
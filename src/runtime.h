@@ -0,0 +1,1944 @@
+#ifndef RUNTIME_H
+#define RUNTIME_H
+
+#include <string_view> // for std::string_view
+
+// C++ code that compiled Nubb++ programs need beyond the standard library. The Parser pastes these into the
+// header of the output file when a program uses them, so out.cpp stays a single file with nothing extra to link.
+namespace runtime
+{
+    // --profile: how many times every source line ran and the time spent in every FUNCTION (callees included),
+    // written to nubb_profile.txt at exit, hottest lines first. Needs nubb_profile::lines and nubb_profile::source
+    // defined before it. Counters are plain increments, so keep profiled programs single threaded.
+    constexpr std::string_view profile { R"nubb(#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nubb_profile
+{
+    unsigned long long counts[lines] {}; // Times every source line ran, loops count their back-edges too
+    unsigned long long ticks[lines] {};  // Time spent in the FUNCTION declared on every source line
+
+#if defined(__x86_64__) || defined(__i386__)
+    constexpr const char* unit { "cycles" };
+    inline unsigned long long now() { return __rdtsc(); }
+#else
+    constexpr const char* unit { "ns" };
+    inline unsigned long long now() { return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+#endif
+
+    // Adds the time from construction to destruction to ticks[line], one for every FUNCTION call
+    struct Timer
+    {
+        int line;
+        unsigned long long start { now() };
+        ~Timer() { ticks[line] += now() - start; }
+    };
+
+    // Writes the report once main() returns or std::exit() is called
+    struct Report
+    {
+        ~Report()
+        {
+            std::vector<int> ran {};
+            for (int line { 1 }; line < lines; line++)
+            {
+                if (counts[line] != 0 || ticks[line] != 0)
+                    ran.push_back(line);
+            }
+            std::sort(ran.begin(), ran.end(), [](int a, int b) { return counts[a] != counts[b] ? counts[a] > counts[b] : ticks[a] > ticks[b]; });
+
+            std::FILE* file { std::fopen("nubb_profile.txt", "w") };
+            if (!file)
+                return;
+
+            std::fprintf(file, "# nubb++ profile 1\n# source %s\n# unit %s\n# line count ticks\n", source, unit);
+            for (int line : ran)
+            {
+                std::fprintf(file, "%d %llu %llu\n", line, counts[line], ticks[line]);
+            }
+            std::fclose(file);
+        }
+    } report {};
+}
+)nubb" };
+
+    // --trace: a complete event for every FUNCTION call, written to nubb_trace.json at exit in Chrome trace-event
+    // format (open it in Perfetto or chrome://tracing). Every thread records into its own fixed size ring buffer
+    // without locking, the oldest events get overwritten once it's full so long runs don't eat memory.
+    constexpr std::string_view trace { R"nubb(#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include <memory>
+
+namespace nubb_trace
+{
+    constexpr size_t capacity { 1 << 16 }; // Events kept per thread
+
+    struct Event
+    {
+        const char* name;
+        long long start; // ns since the program started
+        long long duration;
+    };
+
+    // Events of one thread, only that thread writes to it
+    struct Ring
+    {
+        std::unique_ptr<Event[]> events { new Event[capacity] };
+        size_t written {}; // Events recorded so far, including overwritten ones
+        int thread {};
+    };
+
+    const auto startTime { std::chrono::steady_clock::now() };
+    std::mutex ringsMutex {};                // Only taken when a thread records its first event and at exit
+    std::vector<std::unique_ptr<Ring>> rings {};
+
+    inline long long now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count(); }
+
+    // Ring buffer of the calling thread, made on first use and kept until exit so no events are lost with the thread
+    inline Ring& ring()
+    {
+        thread_local Ring* threadRing { nullptr };
+        if (!threadRing)
+        {
+            std::lock_guard lock { ringsMutex };
+            rings.push_back(std::make_unique<Ring>());
+            threadRing = rings.back().get();
+            threadRing->thread = static_cast<int>(rings.size());
+        }
+        return *threadRing;
+    }
+
+    // Records one FUNCTION call, from construction to destruction
+    struct Scope
+    {
+        const char* name;
+        long long start { now() };
+        ~Scope()
+        {
+            Ring& events { ring() };
+            events.events[events.written % capacity] = Event { name, start, now() - start };
+            events.written++;
+        }
+    };
+
+    // Writes the trace once main() returns or std::exit() is called
+    struct Report
+    {
+        ~Report()
+        {
+            std::FILE* file { std::fopen("nubb_trace.json", "w") };
+            if (!file)
+                return;
+
+            std::lock_guard lock { ringsMutex };
+            const char* separator { "\n" };
+            std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+            for (const auto& events : rings)
+            {
+                size_t first { events->written > capacity ? events->written - capacity : 0 }; // oldest event still around
+                for (size_t i { first }; i < events->written; i++)
+                {
+                    const Event& event { events->events[i % capacity] };
+                    std::fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"ts\": %lld.%03lld, \"dur\": %lld.%03lld, \"pid\": 1, \"tid\": %d}", separator,
+                        event.name, event.start / 1000, event.start % 1000, event.duration / 1000, event.duration % 1000, events->thread);
+                    separator = ",\n";
+                }
+            }
+            std::fprintf(file, "\n]}\n");
+            std::fclose(file);
+        }
+    } report {};
+}
+)nubb" };
+
+    // --pgo-gen: how often every IF/ELIF/WHILE/FOR condition was checked and taken, and how often every FUNCTION
+    // was called, written to nubb_pgo.txt at exit for --pgo-use. Needs nubb_pgo::lines and nubb_pgo::source.
+    constexpr std::string_view pgo { R"nubb(#include <cstdio>
+
+namespace nubb_pgo
+{
+    unsigned long long evaluated[lines] {}; // Times the condition on every source line was checked
+    unsigned long long taken[lines] {};     // Times it was true
+    unsigned long long calls[lines] {};     // Calls of the FUNCTION declared on every source line
+
+    // Counts a condition on its way into an if, while or for
+    inline bool branch(int line, bool condition)
+    {
+        evaluated[line]++;
+        taken[line] += condition;
+        return condition;
+    }
+
+    // Writes the profile once main() returns or std::exit() is called
+    struct Report
+    {
+        ~Report()
+        {
+            std::FILE* file { std::fopen("nubb_pgo.txt", "w") };
+            if (!file)
+                return;
+
+            std::fprintf(file, "# nubb++ pgo 1\n# source %s\n", source);
+            for (int line { 1 }; line < lines; line++)
+            {
+                if (evaluated[line] != 0)
+                    std::fprintf(file, "branch %d %llu %llu\n", line, evaluated[line], taken[line]);
+                if (calls[line] != 0)
+                    std::fprintf(file, "call %d %llu\n", line, calls[line]);
+            }
+            std::fclose(file);
+        }
+    } report {};
+}
+)nubb" };
+
+    // --alloc-profile: arrays and strings get an allocator that counts, for every source line declaring one, how
+    // often it allocated, how often it had to grow (allocating while already holding memory), the peak bytes held
+    // and the size and capacity of the last one to go away. Written to nubb_alloc.txt at exit, busiest lines first.
+    // Pasted in before any declarations since INPUT puts variables in the header. Not thread safe.
+    constexpr std::string_view alloc { R"nubb(#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <initializer_list>
+
+namespace nubb_alloc
+{
+    // What the arrays and strings declared on one source line did
+    struct Site
+    {
+        unsigned long long allocations {};
+        unsigned long long reallocations {};
+        size_t live {};         // Bytes held right now
+        size_t peak {};         // Most bytes held at once
+        size_t size {};         // Elements in the last one destroyed
+        size_t capacity {};     // Capacity of the last one destroyed
+    };
+
+    std::map<int, Site> sites {}; // By declaring source line, map nodes stay put so allocators can keep pointers
+
+    template <typename T>
+    struct Allocator
+    {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::false_type; // keep counting for the line that declared it
+        using is_always_equal = std::false_type;
+
+        int line {};
+        Site* site {};
+        std::shared_ptr<size_t> held {}; // Bytes the owning array or string holds, shared with rebound copies
+
+        explicit Allocator(int line) : line { line }, site { &sites[line] }, held { std::make_shared<size_t>(0) } {}
+        template <typename U>
+        Allocator(const Allocator<U>& other) : line { other.line }, site { other.site }, held { other.held } {}
+
+        Allocator select_on_container_copy_construction() const { return Allocator { line }; } // a copy is its own array
+
+        T* allocate(size_t count)
+        {
+            size_t bytes { count * sizeof(T) };
+            site->allocations++;
+            if (*held != 0) // growing, the old block is freed once the elements are moved over
+                site->reallocations++;
+
+            *held += bytes;
+            site->live += bytes;
+            site->peak = std::max(site->peak, site->live);
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void deallocate(T* pointer, size_t count)
+        {
+            *held -= count * sizeof(T);
+            site->live -= count * sizeof(T);
+            ::operator delete(pointer);
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U>& other) const { return held == other.held; }
+    };
+
+    // Nubb++ array, a std::vector that remembers its size and capacity when it goes away
+    template <typename T>
+    struct Array : std::vector<T, Allocator<T>>
+    {
+        using std::vector<T, Allocator<T>>::vector;
+        using std::vector<T, Allocator<T>>::operator=;
+
+        ~Array()
+        {
+            Site* site { this->get_allocator().site };
+            site->size = this->size();
+            site->capacity = this->capacity();
+        }
+    };
+
+    template <typename T>
+    Array<T> array(int line, std::initializer_list<T> values) { return Array<T>(values, Allocator<T> { line }); }
+
+    // Nubb++ string, same idea as Array
+    struct String : std::basic_string<char, std::char_traits<char>, Allocator<char>>
+    {
+        using Base = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+        using Base::operator=;
+
+        explicit String(int line) : Base(Allocator<char> { line }) {}
+        template <typename Value>
+        String(int line, const Value& value) : Base(std::string_view(value), Allocator<char> { line }) {}
+
+        ~String()
+        {
+            Site* site { get_allocator().site };
+            site->size = size();
+            site->capacity = capacity();
+        }
+    };
+
+    // Writes the report once main() returns or std::exit() is called
+    struct Report
+    {
+        ~Report()
+        {
+            std::vector<std::pair<int, const Site*>> busiest {};
+            for (const auto& [line, site] : sites)
+            {
+                busiest.emplace_back(line, &site);
+            }
+            std::stable_sort(busiest.begin(), busiest.end(), [](const auto& a, const auto& b) { return a.second->allocations > b.second->allocations; });
+
+            std::FILE* file { std::fopen("nubb_alloc.txt", "w") };
+            if (!file)
+                return;
+
+            std::fprintf(file, "# nubb++ alloc 1\n# source %s\n# line allocations reallocations peak_bytes last_size last_capacity\n", source);
+            for (const auto& [line, site] : busiest)
+            {
+                std::fprintf(file, "%d %llu %llu %zu %zu %zu\n", line, site->allocations, site->reallocations, site->peak, site->size, site->capacity);
+            }
+            std::fclose(file);
+        }
+    } report {};
+}
+)nubb" };
+
+    // BENCH name ITER n THEN ... ENDBENCH: warm up, then time every one of n runs of the body with steady_clock.
+    // Prints one line per benchmark through print's buffer, in a fixed format so results can be diffed across compilers:
+    // BENCH name iterations=n min_ns=... median_ns=... p99_ns=...
+    constexpr std::string_view bench { R"nubb(#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+namespace nubb_bench
+{
+    // Tells the compiler memory may have been read and written, so work the body stores can't be thrown away
+    inline void barrier()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" ::: "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    template <typename Body>
+    void run(const char* name, long long iterations, Body&& body)
+    {
+        if (iterations < 1)
+            iterations = 1;
+
+        for (long long i { 0 }; i < std::max(1LL, iterations / 10); i++) // warm up caches and branch predictors
+        {
+            body();
+            barrier();
+        }
+
+        std::vector<long long> times(static_cast<size_t>(iterations));
+        for (auto& time : times)
+        {
+            auto start { std::chrono::steady_clock::now() };
+            body();
+            barrier();
+            time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::sort(times.begin(), times.end());
+        size_t p99 { std::min(times.size() - 1, times.size() * 99 / 100) };
+        // through the PRINT buffer so it comes out in order with everything else
+        nubb_io::out.put("BENCH ");
+        nubb_io::out.put(name);
+        nubb_io::out.put(" iterations=");
+        nubb_io::out.put(iterations);
+        nubb_io::out.put(" min_ns=");
+        nubb_io::out.put(times.front());
+        nubb_io::out.put(" median_ns=");
+        nubb_io::out.put(times[times.size() / 2]);
+        nubb_io::out.put(" p99_ns=");
+        nubb_io::out.put(times[p99]);
+        nubb_io::out.put('\n');
+    }
+}
+)nubb" };
+
+    // PRINT output: one big buffer written with a single write(2) whenever it fills up, before INPUT reads anything
+    // and at exit. Numbers are formatted with std::to_chars, floating point the same way std::cout does by default.
+    constexpr std::string_view print { R"nubb(#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace nubb_io
+{
+    struct Output
+    {
+        static constexpr size_t capacity { 1 << 16 };
+        char buffer[capacity];
+        size_t used {};
+        int fd { 1 }; // stdout, WRITE gives every file its own Output
+
+        // Hand everything buffered so far to the OS
+        void flush()
+        {
+            writeAll(buffer, used);
+            used = 0;
+        }
+
+        void writeAll(const char* data, size_t size)
+        {
+#if defined(_WIN32)
+            ::_write(fd, data, static_cast<unsigned int>(size));
+#else
+            while (size > 0)
+            {
+                ssize_t written { ::write(fd, data, size) };
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return; // nowhere left to write to
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+#endif
+        }
+
+        // Make sure size more bytes fit
+        char* reserve(size_t size)
+        {
+            if (used + size > capacity)
+                flush();
+            return buffer + used;
+        }
+
+        void put(std::string_view text)
+        {
+            if (text.size() > capacity) // too big to buffer, write it straight out
+            {
+                flush();
+                writeAll(text.data(), text.size());
+                return;
+            }
+            std::memcpy(reserve(text.size()), text.data(), text.size());
+            used += text.size();
+        }
+
+        void put(const char* text) { put(std::string_view { text }); }
+        void put(char c) { *reserve(1) = c; used++; }
+        void put(bool value) { put(value ? '1' : '0'); } // same as std::cout
+
+        template <typename T> requires std::is_integral_v<T>
+        void put(T value)
+        {
+            char* first { reserve(32) };
+            used = static_cast<size_t>(std::to_chars(first, buffer + capacity, value).ptr - buffer);
+        }
+
+        template <typename T> requires std::is_floating_point_v<T>
+        void put(T value)
+        {
+            char* first { reserve(64) };
+            used = static_cast<size_t>(std::to_chars(first, buffer + capacity, value, std::chars_format::general, 6).ptr - buffer); // std::cout's default %g
+        }
+
+        template <typename T> requires (!std::is_arithmetic_v<T> && std::is_convertible_v<const T&, std::string_view>)
+        void put(const T& text) { put(std::string_view { text }); }
+
+        ~Output() { flush(); }
+    } out {};
+}
+)nubb" };
+
+    // INPUT: stdin is memory mapped when it's a regular file, otherwise read in big blocks, and tokens are parsed
+    // with std::from_chars. Invalid input recovers like std::cin did with clear() and ignore(): the variable gets
+    // 0 and the rest of the line is skipped. Output is flushed before blocking on a read so prompts show up.
+    // Needs print before it.
+    constexpr std::string_view input { R"nubb(#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#if defined(_WIN32)
+#include <cstdio>
+#else
+#include <unistd.h>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace nubb_io
+{
+    struct Input
+    {
+        const char* data {};         // Unread input is data[pos, end)
+        size_t pos {};
+        size_t end {};
+        std::vector<char> buffer {}; // Holds data when stdin isn't mapped
+        bool started { false };
+        bool finished { false };     // Nothing left to read from stdin
+
+        static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+        void start()
+        {
+            started = true;
+#if !defined(_WIN32)
+            struct stat info {};
+            off_t offset { ::lseek(0, 0, SEEK_CUR) };
+            if (::fstat(0, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0 && offset >= 0)
+            {
+                void* mapped { ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, 0, 0) };
+                if (mapped != MAP_FAILED)
+                {
+                    ::madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                    data = static_cast<const char*>(mapped);
+                    pos = static_cast<size_t>(offset);
+                    end = static_cast<size_t>(info.st_size);
+                    finished = true;
+                    return;
+                }
+            }
+#endif
+            buffer.resize(1 << 16);
+            data = buffer.data();
+        }
+
+        // Read more of stdin in after whatever is still unread, false once there's no more
+        bool refill()
+        {
+            if (finished)
+                return false;
+            out.flush(); // about to wait for input, the prompt has to be on screen
+
+            size_t left { end - pos };
+            std::memmove(buffer.data(), buffer.data() + pos, left);
+            pos = 0;
+            end = left;
+            if (end == buffer.size()) // one token filling the whole buffer
+                buffer.resize(buffer.size() * 2);
+            data = buffer.data();
+
+#if defined(_WIN32)
+            size_t got { std::fread(buffer.data() + end, 1, buffer.size() - end, stdin) };
+#else
+            ssize_t got { ::read(0, buffer.data() + end, buffer.size() - end) };
+            while (got < 0 && errno == EINTR)
+            {
+                got = ::read(0, buffer.data() + end, buffer.size() - end);
+            }
+#endif
+            if (got <= 0)
+            {
+                finished = true;
+                return false;
+            }
+            end += static_cast<size_t>(got);
+            return true;
+        }
+
+        // Next whitespace separated token, left unread so callers consume only what they parse
+        std::string_view token()
+        {
+            if (!started)
+                start();
+
+            while (true) // skip whitespace, which may run over several reads
+            {
+                while (pos < end && isSpace(data[pos]))
+                {
+                    pos++;
+                }
+                if (pos < end || !refill())
+                    break;
+            }
+
+            size_t length { 0 };
+            while (true)
+            {
+                while (pos + length < end && !(isSpace(data[pos + length])))
+                {
+                    length++;
+                }
+                if (pos + length < end || !refill()) // token ends in what we have, or input does
+                    break;
+            }
+            return std::string_view { data + pos, length };
+        }
+
+        // Invalid input, skip the rest of the line like std::cin.ignore(max, '\n')
+        void fail()
+        {
+            while (true)
+            {
+                const void* newline { std::memchr(data + pos, '\n', end - pos) };
+                if (newline)
+                {
+                    pos = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+                    return;
+                }
+                pos = end;
+                if (!refill())
+                    return;
+            }
+        }
+
+        template <typename T> requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        void read(T& value)
+        {
+            std::string_view text { token() };
+            if (text.size() > 1 && text.front() == '+' && text[1] != '-') // from_chars doesn't take a leading +
+                text.remove_prefix(1);
+
+            size_t digit { (!(text.empty()) && text.front() == '-') ? size_t { 1 } : size_t { 0 } };
+            bool number { digit < text.size() && ((text[digit] >= '0' && text[digit] <= '9') || text[digit] == '.') };
+
+            auto [parsed, error] { std::from_chars(text.data(), text.data() + text.size(), value) };
+            if (!(number) || error == std::errc::invalid_argument) // std::cin doesn't take inf or nan either
+            {
+                value = 0;
+                fail();
+                return;
+            }
+            if (error == std::errc::result_out_of_range)
+            {
+                value = (text.front() == '-') ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+                fail();
+                return;
+            }
+            pos = static_cast<size_t>(parsed - data); // anything after the number is left for the next INPUT
+        }
+
+        void read(bool& value) // 0 or 1, like std::cin without std::boolalpha
+        {
+            long long number {};
+            read(number);
+            value = number != 0;
+            if (number != 0 && number != 1)
+                fail();
+        }
+
+        template <typename T> requires requires (T& text) { text.assign("", size_t {}); }
+        void read(T& text)
+        {
+            std::string_view word { token() };
+            if (word.empty()) // end of input
+                return;
+            text.assign(word.data(), word.size());
+            pos += word.size();
+        }
+    } in {};
+}
+)nubb" };
+
+    // FOREACH LINE and WRITE. Input files are memory mapped and every line is a std::string_view into the mapping
+    // (without its newline), so a loop over a huge file only keeps the pages it's reading in memory. Every WRITE path
+    // gets a buffered nubb_io::Output that's opened, and emptied, by the first WRITE to it. Needs print before it.
+    constexpr std::string_view file { R"nubb(#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace nubb_file
+{
+    [[noreturn]] inline void fail(const char* what, std::string_view path)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, "[FATAL] %s: %.*s\n", what, static_cast<int>(path.size()), path.data());
+        std::exit(1);
+    }
+
+    class Lines
+    {
+        const char* data {};
+        size_t size {};
+        bool mapped { false };
+        std::string copy {}; // whole file, when it can't be mapped (pipes, or no mmap)
+
+    public:
+        struct Iterator
+        {
+            const char* pos {};
+            const char* end {};
+            std::string_view line {};
+            const char* kept {}; // mapped pages before this are handed back, nullptr when the file isn't mapped
+
+            static constexpr size_t releaseEvery { 1 << 26 }; // 64MB, a multiple of any page size
+
+            Iterator& operator++()
+            {
+                if (pos == end)
+                {
+                    pos = nullptr; // past the last line
+                    return *this;
+                }
+                const char* newline { static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos))) };
+                const char* lineEnd { newline ? newline : end };
+                line = std::string_view { pos, static_cast<size_t>(lineEnd - pos) };
+                if (!(line.empty()) && line.back() == '\r') // Windows line endings
+                    line.remove_suffix(1);
+                pos = newline ? newline + 1 : end;
+                if (!(newline) && line.empty()) // file ended with a newline, there's no empty line after it
+                    pos = nullptr;
+
+#if !defined(_WIN32)
+                // keep memory flat on huge files. The pages come back from the file if a stored line still points there
+                if (kept && static_cast<size_t>(lineEnd - kept) >= releaseEvery)
+                {
+                    size_t released { static_cast<size_t>(lineEnd - kept) / releaseEvery * releaseEvery };
+                    ::madvise(const_cast<char*>(kept), released, MADV_DONTNEED);
+                    kept += released;
+                }
+#endif
+                return *this;
+            }
+
+            std::string_view operator*() const { return line; }
+            bool operator!=(const Iterator& other) const { return pos != other.pos; }
+        };
+
+        explicit Lines(std::string_view path)
+        {
+            std::string name { path };
+            int fd { ::open(name.c_str(), O_RDONLY) };
+            if (fd < 0)
+                fail("Cannot open file for FOREACH LINE", path);
+
+#if !defined(_WIN32)
+            struct stat info {};
+            if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+            {
+                size = static_cast<size_t>(info.st_size);
+                if (size == 0)
+                {
+                    ::close(fd);
+                    return;
+                }
+                void* pages { ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) };
+                if (pages != MAP_FAILED)
+                {
+                    ::madvise(pages, size, MADV_SEQUENTIAL); // read ahead, drop pages behind
+                    data = static_cast<const char*>(pages);
+                    mapped = true;
+                    ::close(fd);
+                    return;
+                }
+            }
+#endif
+            char block[1 << 16];
+            for (long got { ::read(fd, block, sizeof(block)) }; got > 0; got = ::read(fd, block, sizeof(block)))
+            {
+                copy.append(block, static_cast<size_t>(got));
+            }
+            ::close(fd);
+            data = copy.data();
+            size = copy.size();
+        }
+
+        Lines(const Lines&) = delete;
+        Lines& operator=(const Lines&) = delete;
+
+        ~Lines()
+        {
+#if !defined(_WIN32)
+            if (mapped)
+                ::munmap(const_cast<char*>(data), size);
+#endif
+        }
+
+        Iterator begin() const
+        {
+            Iterator first { data, data + size, {}, mapped ? data : nullptr };
+            if (size == 0)
+                first.pos = nullptr;
+            else
+                ++first;
+            return first;
+        }
+        Iterator end() const { return Iterator {}; }
+    };
+
+    struct Writer
+    {
+        std::string path {};
+        nubb_io::Output out {};
+
+        template <typename T>
+        void line(const T& value)
+        {
+            out.put(value);
+            out.put('\n');
+        }
+
+        ~Writer()
+        {
+            out.flush();
+            ::close(out.fd);
+        }
+    };
+
+    inline std::vector<std::unique_ptr<Writer>> writers {};
+
+    // Writer for path, opening it on first use. WRITEs in a row usually go to the same file, so that's checked first
+    inline Writer& writer(std::string_view path)
+    {
+        static Writer* last { nullptr };
+        if (last && last->path == path)
+            return *last;
+
+        for (std::unique_ptr<Writer>& open : writers)
+        {
+            if (open->path == path)
+                return *(last = open.get());
+        }
+
+        std::unique_ptr<Writer> created { std::make_unique<Writer>() };
+        created->path = path;
+        created->out.fd = ::open(created->path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (created->out.fd < 0)
+            fail("Cannot open file for WRITE", path);
+
+        writers.push_back(std::move(created));
+        return *(last = writers.back().get());
+    }
+}
+)nubb" };
+
+    // --bounds=check and --bounds=hoist: array indexes are checked against the array's size and a bad one stops the
+    // program with the Nubb++ line it happened on. FOR loops whose indexes got checked up front by loop() pass
+    // hoisted = true so their own checks compile away. Needs print before it.
+    constexpr std::string_view bounds { R"nubb(#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace nubb_bounds
+{
+    [[noreturn, gnu::cold, gnu::noinline]] inline void fail(long long index, size_t size, int line)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, "[FATAL] Array index %lld is out of bounds for size %zu on line %d\n", index, size, line);
+        std::exit(1);
+    }
+
+    // constexpr so PURE FUNCTIONs can index too, a bad index then stops the C++ compiler instead
+    template <bool hoisted = false, typename Array, typename Index>
+    constexpr Index at(const Array& array, Index index, int line)
+    {
+        if constexpr (!(hoisted))
+        {
+            if (static_cast<unsigned long long>(index) >= array.size()) [[unlikely]] // negative ones wrap around
+                fail(static_cast<long long>(index), array.size(), line);
+        }
+        return index;
+    }
+
+    // Before a FOR loop taking index from 0 up to end (or just below it) by step: the last index it reaches has to fit
+    template <typename Array, typename End>
+    constexpr void loop(const Array& array, End end, bool inclusive, long long step, int line)
+    {
+        long long last {};
+        if constexpr (std::is_floating_point_v<End>)
+            last = static_cast<long long>(inclusive ? std::floor(end) : std::ceil(end) - 1);
+        else
+            last = static_cast<long long>(end) - (inclusive ? 0 : 1);
+        if (last > 0)
+            last -= last % step; // a stride can stop short of end
+
+        if (last >= 0 && static_cast<unsigned long long>(last) >= array.size()) [[unlikely]]
+            fail(last, array.size(), line);
+    }
+}
+)nubb" };
+
+    // PARALLEL FOR: a pool of worker threads (NUBB_THREADS of them, every core by default) started by the first
+    // PARALLEL FOR and kept waiting for the next one. The index range is cut into chunks of GRAIN iterations
+    // that the workers and the calling thread grab until none are left.
+    constexpr std::string_view parallel { R"nubb(#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace nubb_parallel
+{
+    class Pool
+    {
+    public:
+        // Never destroyed, the workers are still waiting on it when the program exits
+        static Pool& get()
+        {
+            static Pool* pool { new Pool {} };
+            return *pool;
+        }
+
+        long long threads() const { return workers + 1; }
+
+        // body(first, last) for every chunk of [0, end), chunk is a multiple of the loop's step
+        template <typename Body>
+        void run(long long end, long long chunk, Body& body)
+        {
+            {
+                std::lock_guard lock { mutex };
+                call = [](void* body, long long first, long long last) { (*static_cast<Body*>(body))(first, last); };
+                this->body = &body;
+                this->end = end;
+                this->chunk = chunk;
+                next.store(0, std::memory_order_relaxed);
+                busy = workers;
+                generation++;
+            }
+            wake.notify_all();
+            work();
+
+            std::unique_lock lock { mutex };
+            done.wait(lock, [this] { return busy == 0; });
+        }
+
+    private:
+        Pool()
+        {
+            long long count { std::thread::hardware_concurrency() };
+            if (const char* setting { std::getenv("NUBB_THREADS") }; setting && std::atoll(setting) > 0)
+                count = std::atoll(setting);
+
+            workers = std::max(count, 1LL) - 1; // the thread running the loop helps out
+            for (long long i { 0 }; i < workers; i++)
+            {
+                std::thread { [this] { wait(); } }.detach();
+            }
+        }
+
+        void work()
+        {
+            for (long long first { next.fetch_add(chunk, std::memory_order_relaxed) }; first < end; first = next.fetch_add(chunk, std::memory_order_relaxed))
+            {
+                call(body, first, std::min(end, first + chunk));
+            }
+        }
+
+        void wait()
+        {
+            unsigned long long seen { 0 };
+            std::unique_lock lock { mutex };
+            while (true)
+            {
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+
+                lock.unlock();
+                work();
+                lock.lock();
+
+                if (--busy == 0)
+                    done.notify_one();
+            }
+        }
+
+        long long workers { 0 };
+        std::mutex mutex {};
+        std::condition_variable wake {};       // a new loop is ready
+        std::condition_variable done {};       // every worker is through with the loop
+        unsigned long long generation { 0 };   // loops handed out so far
+        long long busy { 0 };                  // workers not through with the current loop yet
+
+        void (*call)(void*, long long, long long) {};
+        void* body {};
+        long long end { 0 };
+        long long chunk { 1 };
+        std::atomic<long long> next { 0 };     // start of the next chunk nobody has taken
+    };
+
+    [[noreturn, gnu::cold, gnu::noinline]] inline void fail(long long step, int line)
+    {
+        std::fprintf(stderr, "[FATAL] PARALLEL FOR step %lld has to be at least 1 on line %d\n", step, line);
+        std::exit(1);
+    }
+
+    // PARALLEL FOR over [0, end) in steps of step. serial runs it all on the calling thread, for instrumented builds.
+    template <bool serial = false, typename Body>
+    void run(int line, long long end, long long step, long long grain, Body&& body)
+    {
+        if (step < 1)
+            fail(step, line);
+        if (end <= 0)
+            return;
+
+        long long iterations { (end - 1) / step + 1 };
+        if constexpr (!(serial))
+        {
+            Pool& pool { Pool::get() };
+            if (grain < 1) // a few chunks per thread, so ones that finish early can take over some of the work
+                grain = std::max(1LL, iterations / (pool.threads() * 4));
+
+            if (pool.threads() > 1 && iterations > grain)
+            {
+                pool.run(end, grain * step, body);
+                return;
+            }
+        }
+        body(0LL, end);
+    }
+
+    inline std::mutex combining {}; // REDUCE results go into the real variable one at a time
+
+    template <char op, typename T>
+    constexpr std::remove_cvref_t<T> identity(const T&)
+    {
+        if constexpr (op == '*')
+            return 1;
+        else
+            return {};
+    }
+
+    template <char op, typename T, typename U>
+    void combine(T& shared, const U& partial)
+    {
+        std::lock_guard lock { combining };
+        if constexpr (op == '*')
+            shared *= partial;
+        else
+            shared += partial;
+    }
+}
+)nubb" };
+
+    // array<bool>: 64 elements packed into every word instead of a byte each. Unlike std::vector<bool> there are no
+    // references to single bits, an element is read as a plain bool and changed with set(), so nothing that takes
+    // the address of an element compiles by accident. Bits past the end of the last word are always 0, which lets
+    // count(), find() and sort() work a whole word at a time.
+    constexpr std::string_view bits { R"nubb(#include <bit>
+#include <cstdint>
+#include <vector>
+#include <initializer_list>
+
+namespace nubb_bits
+{
+    class Bits
+    {
+    public:
+        using value_type = bool;
+
+        // Reads elements in order, for FOR EACH
+        class Iterator
+        {
+        public:
+            using value_type = bool;
+            using difference_type = std::ptrdiff_t;
+
+            constexpr Iterator() = default;
+            constexpr Iterator(const Bits* bits, size_t index) : bits { bits }, index { index } {}
+
+            constexpr bool operator*() const { return (*bits)[index]; }
+            constexpr Iterator& operator++() { index++; return *this; }
+            constexpr Iterator operator++(int) { Iterator old { *this }; index++; return old; }
+            constexpr bool operator==(const Iterator& other) const { return index == other.index; }
+
+        private:
+            const Bits* bits {};
+            size_t index {};
+        };
+
+        constexpr Bits() = default;
+        constexpr Bits(std::initializer_list<bool> values)
+        {
+            reserve(values.size());
+            for (bool value : values)
+            {
+                push_back(value);
+            }
+        }
+
+        constexpr size_t size() const { return length; }
+        constexpr bool empty() const { return length == 0; }
+        constexpr bool operator[](size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+        constexpr Iterator begin() const { return Iterator { this, 0 }; }
+        constexpr Iterator end() const { return Iterator { this, length }; }
+
+        constexpr void set(size_t i, bool value)
+        {
+            std::uint64_t bit { std::uint64_t { 1 } << (i % 64) };
+            words[i / 64] = (words[i / 64] & ~bit) | (-std::uint64_t { value } & bit);
+        }
+
+        constexpr void push_back(bool value)
+        {
+            if (length % 64 == 0)
+                words.push_back(0);
+            set(length++, value);
+        }
+
+        constexpr void pop_back()
+        {
+            set(--length, false);
+            if (length % 64 == 0)
+                words.pop_back();
+        }
+
+        constexpr void reserve(size_t count) { words.reserve((count + 63) / 64); }
+
+        constexpr void resize(size_t count)
+        {
+            words.resize((count + 63) / 64);
+            length = count;
+            clearPadding();
+        }
+
+        // Elements that are true, SUM
+        constexpr long long count() const
+        {
+            long long total { 0 };
+            for (std::uint64_t word : words)
+            {
+                total += std::popcount(word);
+            }
+            return total;
+        }
+
+        // Index of the first element equal to value, -1 if there isn't one
+        constexpr long long find(bool value) const
+        {
+            for (size_t w { 0 }; w < words.size(); w++)
+            {
+                std::uint64_t word { value ? words[w] : ~words[w] };
+                if (word != 0)
+                {
+                    size_t i { w * 64 + static_cast<size_t>(std::countr_zero(word)) };
+                    return i < length ? static_cast<long long>(i) : -1; // the padding reads as false
+                }
+            }
+            return -1;
+        }
+
+        // False first, then true: the last count() elements end up true
+        constexpr void sort()
+        {
+            size_t falses { length - static_cast<size_t>(count()) };
+            for (size_t w { 0 }; w < words.size(); w++)
+            {
+                size_t first { w * 64 };
+                if (first + 64 <= falses)
+                    words[w] = 0;
+                else
+                    words[w] = ~std::uint64_t { 0 } << (falses > first ? falses - first : 0);
+            }
+            clearPadding();
+        }
+
+    private:
+        constexpr void clearPadding()
+        {
+            if (length % 64 != 0)
+                words.back() &= (std::uint64_t { 1 } << (length % 64)) - 1;
+        }
+
+        std::vector<std::uint64_t> words {};
+        size_t length {};
+    };
+}
+)nubb" };
+
+    // SUM, MIN, MAX, FIND and SORT on whole arrays, through the standard algorithms so they get vectorized.
+    // Compiling out.cpp with -DNUBB_PARALLEL_ALGORITHMS spreads big arrays over every core with std::execution::par_unseq,
+    // which libstdc++ runs on TBB, so link with -ltbb then. Everything is constexpr for CONSTs and PURE FUNCTIONs.
+    constexpr std::string_view algorithm { R"nubb(#include <algorithm>
+#include <numeric>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+#include <execution>
+#endif
+
+namespace nubb_algo
+{
+    // Arrays smaller than this aren't worth handing to other threads
+    constexpr size_t parallelSize { 1 << 16 };
+
+    template <typename Array>
+    constexpr bool parallel([[maybe_unused]] const Array& array)
+    {
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+        return !(std::is_constant_evaluated()) && array.size() >= parallelSize;
+#else
+        return false;
+#endif
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]] inline void empty(const char* what, int line)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, "[FATAL] %s of an empty array on line %d\n", what, line);
+        std::exit(1);
+    }
+
+    // Adds up in whatever adding two elements gives, so i8 to u16 (and bool) elements add up as int instead of wrapping.
+    // A packed array<bool> has its own count(), find() and sort() working a word at a time
+    template <typename Array>
+    constexpr auto sum(const Array& array)
+    {
+        using Total = decltype(typename Array::value_type {} + typename Array::value_type {});
+        if constexpr (requires { array.count(); })
+        {
+            return array.count();
+        }
+        else
+        {
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+            if (parallel(array))
+                return std::reduce(std::execution::par_unseq, array.begin(), array.end(), Total {});
+#endif
+            return std::reduce(array.begin(), array.end(), Total {}); // may add in any order, so it vectorizes
+        }
+    }
+
+    template <typename Array>
+    constexpr typename Array::value_type min(const Array& array, int line)
+    {
+        if (array.size() == 0)
+            empty("MIN", line);
+        if constexpr (requires { array.count(); })
+        {
+            return static_cast<size_t>(array.count()) == array.size();
+        }
+        else
+        {
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+            if (parallel(array))
+                return *std::min_element(std::execution::par_unseq, array.begin(), array.end());
+#endif
+            return *std::min_element(array.begin(), array.end());
+        }
+    }
+
+    template <typename Array>
+    constexpr typename Array::value_type max(const Array& array, int line)
+    {
+        if (array.size() == 0)
+            empty("MAX", line);
+        if constexpr (requires { array.count(); })
+        {
+            return array.count() != 0;
+        }
+        else
+        {
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+            if (parallel(array))
+                return *std::max_element(std::execution::par_unseq, array.begin(), array.end());
+#endif
+            return *std::max_element(array.begin(), array.end());
+        }
+    }
+
+    // Index of the first element equal to value, -1 if there isn't one
+    template <typename Array, typename Value>
+    constexpr int find(const Array& array, const Value& value)
+    {
+        if constexpr (requires { array.find(value); })
+        {
+            return static_cast<int>(array.find(value));
+        }
+        else
+        {
+            auto found { array.end() };
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+            if (parallel(array))
+                found = std::find(std::execution::par_unseq, array.begin(), array.end(), value);
+            else
+#endif
+                found = std::find(array.begin(), array.end(), value);
+            return found == array.end() ? -1 : static_cast<int>(found - array.begin());
+        }
+    }
+
+    template <typename Array>
+    constexpr void sort(Array& array)
+    {
+        if constexpr (requires { array.sort(); })
+        {
+            array.sort();
+        }
+        else
+        {
+#if defined(NUBB_PARALLEL_ALGORITHMS)
+            if (parallel(array))
+            {
+                std::sort(std::execution::par_unseq, array.begin(), array.end());
+                return;
+            }
+#endif
+            std::sort(array.begin(), array.end());
+        }
+    }
+}
+)nubb" };
+
+    // Whole-array expressions like 'LET array c = a + b * 2'. The parser turns the expression into a lambda working out
+    // element i, and map/assign run it in a single loop over every element: no array per operator, and nothing
+    // in the way of the compiler vectorizing it. Every array in the expression has to be the same size.
+    constexpr std::string_view elementwise { R"nubb(#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+namespace nubb_array
+{
+    [[noreturn, gnu::cold, gnu::noinline]] inline void fail(size_t size, size_t expected, int line)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, "[FATAL] Array of size %zu used with one of size %zu in an array expression on line %d\n", size, expected, line);
+        std::exit(1);
+    }
+
+    template <typename Array, typename... Arrays>
+    constexpr size_t size([[maybe_unused]] int line, const Array& array, const Arrays&... arrays)
+    {
+        size_t count { array.size() };
+        ((arrays.size() == count ? void() : fail(arrays.size(), count, line)), ...);
+        return count;
+    }
+
+    // array<type, size> can't change size, so it has to fit already
+    template <typename Array>
+    constexpr void resize(Array& array, size_t count, int line)
+    {
+        if constexpr (requires { array.resize(count); })
+            array.resize(count);
+        else if (array.size() != count)
+            fail(array.size(), count, line);
+    }
+
+    template <typename Array, typename Element>
+    constexpr void fill(Array& array, size_t count, const Element& element)
+    {
+        if constexpr (requires { array.data(); }) // straight through the pointer, array<bool> has none
+        {
+            auto* out { array.data() };
+            for (size_t i { 0 }; i < count; i++)
+            {
+                out[i] = element(i);
+            }
+        }
+        else if constexpr (requires { array.set(0, element(0)); }) // array<bool>, packed
+        {
+            for (size_t i { 0 }; i < count; i++)
+            {
+                array.set(i, element(i));
+            }
+        }
+        else
+        {
+            for (size_t i { 0 }; i < count; i++)
+            {
+                array[i] = element(i);
+            }
+        }
+    }
+
+    // New array, a std::vector of whatever the elements come out as (packed if they're bools) unless the LET gave a type
+    template <typename Result = void, typename Element, typename... Arrays>
+    constexpr auto map(int line, const Element& element, const Arrays&... arrays)
+    {
+        size_t count { size(line, arrays...) };
+        using Value = std::remove_cvref_t<decltype(element(0))>;
+        if constexpr (std::is_void_v<Result>)
+        {
+            std::conditional_t<std::is_same_v<Value, bool>, nubb_bits::Bits, std::vector<Value>> result {};
+            result.resize(count);
+            fill(result, count, element);
+            return result;
+        }
+        else
+        {
+            Result result {};
+            resize(result, count, line);
+            fill(result, count, element);
+            return result;
+        }
+    }
+
+    // Existing array, which can be in the expression itself since element i only ever uses element i
+    template <typename Array, typename Element, typename... Arrays>
+    constexpr void assign(Array& array, int line, const Element& element, const Arrays&... arrays)
+    {
+        size_t count { size(line, arrays...) };
+        resize(array, count, line);
+        fill(array, count, element);
+    }
+}
+)nubb" };
+
+    // map<key, value>: an open addressing hash table in three flat arrays (control bytes, keys, values), no allocation
+    // per entry. Every slot has a control byte that's EMPTY, ERASED or 7 bits of its key's hash, and a lookup compares
+    // a whole group of 16 of them against the hash at once (one SSE2 compare where there is one) before it looks at
+    // any keys. Groups are probed with growing steps, the table doubles when it gets 7/8 full.
+    constexpr std::string_view map { R"nubb(#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <initializer_list>
+#include <type_traits>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nubb_map
+{
+    [[noreturn, gnu::cold, gnu::noinline]] inline void missing(int line)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, "[FATAL] Key not found in map on line %d\n", line);
+        std::exit(1);
+    }
+
+    // Mixed at the end, so keys 0, 1, 2... spread over every group instead of filling the first one
+    template <typename Key>
+    constexpr std::uint64_t hash(const Key& key)
+    {
+        std::uint64_t value { 14695981039346656037ull };
+        if constexpr (std::is_same_v<Key, std::string_view>) // FNV-1a
+        {
+            for (char c : key)
+            {
+                value ^= static_cast<unsigned char>(c);
+                value *= 1099511628211ull;
+            }
+        }
+        else if constexpr (std::is_floating_point_v<Key>)
+            value = std::bit_cast<std::uint64_t>(static_cast<double>(key) + 0.0); // -0.0 is 0.0
+        else
+            value = static_cast<std::uint64_t>(key);
+
+        value ^= value >> 32;
+        value *= 0xd6e8feb86659fd93ull;
+        value ^= value >> 32;
+        return value;
+    }
+
+    template <typename Key, typename Value>
+    class Map
+    {
+    public:
+        // string keys are looked up without making a std::string
+        using Lookup = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+        constexpr Map() = default;
+        constexpr Map(std::initializer_list<std::pair<Lookup, Value>> entries)
+        {
+            for (const auto& [key, value] : entries)
+            {
+                insert(key, value);
+            }
+        }
+
+        constexpr size_t size() const { return count; }
+        constexpr bool contains(Lookup key) const { return find(key) != NONE; }
+
+        constexpr const Value& at(Lookup key, int line) const
+        {
+            size_t slot { find(key) };
+            if (slot == NONE)
+                missing(line);
+            return values[slot];
+        }
+
+        // replaces the value if key is there already
+        constexpr void insert(Lookup key, Value value)
+        {
+            if (size_t slot { find(key) }; slot != NONE)
+            {
+                values[slot] = std::move(value);
+                return;
+            }
+            if ((count + erased + 1) * 8 > control.size() * 7)
+                rehash((count + 1) * 2 > control.size() ? std::max(control.size() * 2, GROUP) : control.size()); // or just clear out ERASED slots
+            place(key, std::move(value));
+        }
+
+        constexpr void erase(Lookup key)
+        {
+            size_t slot { find(key) };
+            if (slot == NONE)
+                return;
+
+            // a lookup stops at a group with an EMPTY slot anyway, so only full groups need ERASED to keep probing
+            if (matching(slot / GROUP, EMPTY) != 0)
+                control[slot] = EMPTY;
+            else
+            {
+                control[slot] = ERASED;
+                erased++;
+            }
+            keys[slot] = Key {};
+            values[slot] = Value {};
+            count--;
+        }
+
+    private:
+        static constexpr std::int8_t EMPTY { -128 };
+        static constexpr std::int8_t ERASED { -2 };
+        static constexpr size_t GROUP { 16 };
+        static constexpr size_t NONE { static_cast<size_t>(-1) };
+
+        std::vector<std::int8_t> control {};  // sign bit set for EMPTY and ERASED, otherwise the low 7 bits of the hash
+        std::vector<Key> keys {};
+        std::vector<Value> values {};
+        size_t count { 0 };                   // full slots
+        size_t erased { 0 };                  // ERASED slots
+
+        static constexpr std::int8_t tag(std::uint64_t hashed) { return static_cast<std::int8_t>(hashed & 0x7f); }
+
+        // bit i set when control byte i of group is byte
+        constexpr std::uint32_t matching(size_t group, std::int8_t byte) const
+        {
+            const std::int8_t* bytes { control.data() + group * GROUP };
+#if defined(__SSE2__)
+            if (!(std::is_constant_evaluated()))
+            {
+                __m128i loaded { _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)) };
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(loaded, _mm_set1_epi8(byte))));
+            }
+#endif
+            std::uint32_t mask { 0 };
+            for (size_t i { 0 }; i < GROUP; i++)
+            {
+                mask |= static_cast<std::uint32_t>(bytes[i] == byte) << i;
+            }
+            return mask;
+        }
+
+        // bit i set when slot i of group is EMPTY or ERASED
+        constexpr std::uint32_t vacant(size_t group) const
+        {
+            const std::int8_t* bytes { control.data() + group * GROUP };
+#if defined(__SSE2__)
+            if (!(std::is_constant_evaluated()))
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))));
+#endif
+            std::uint32_t mask { 0 };
+            for (size_t i { 0 }; i < GROUP; i++)
+            {
+                mask |= static_cast<std::uint32_t>(bytes[i] < 0) << i;
+            }
+            return mask;
+        }
+
+        constexpr size_t find(Lookup key) const
+        {
+            if (count == 0)
+                return NONE;
+
+            std::uint64_t hashed { hash(key) };
+            size_t groups { control.size() / GROUP - 1 };
+            size_t group { static_cast<size_t>(hashed >> 7) & groups };
+            for (size_t step { 1 };; step++) // 1, 2, 3... apart, which reaches every group of a power of two
+            {
+                for (std::uint32_t hits { matching(group, tag(hashed)) }; hits != 0; hits &= hits - 1)
+                {
+                    size_t slot { group * GROUP + static_cast<size_t>(std::countr_zero(hits)) };
+                    if (keys[slot] == key)
+                        return slot;
+                }
+                if (matching(group, EMPTY) != 0)
+                    return NONE;
+                group = (group + step) & groups;
+            }
+        }
+
+        // key isn't in the table and there's room for it
+        constexpr void place(Lookup key, Value value)
+        {
+            std::uint64_t hashed { hash(key) };
+            size_t groups { control.size() / GROUP - 1 };
+            size_t group { static_cast<size_t>(hashed >> 7) & groups };
+            for (size_t step { 1 };; step++)
+            {
+                if (std::uint32_t free { vacant(group) }; free != 0)
+                {
+                    size_t slot { group * GROUP + static_cast<size_t>(std::countr_zero(free)) };
+                    if (control[slot] == ERASED)
+                        erased--;
+                    control[slot] = tag(hashed);
+                    keys[slot] = Key(key);
+                    values[slot] = std::move(value);
+                    count++;
+                    return;
+                }
+                group = (group + step) & groups;
+            }
+        }
+
+        constexpr void rehash(size_t slots)
+        {
+            std::vector<std::int8_t> oldControl(slots, EMPTY);
+            std::vector<Key> oldKeys(slots);
+            std::vector<Value> oldValues(slots);
+            control.swap(oldControl);
+            keys.swap(oldKeys);
+            values.swap(oldValues);
+            count = 0;
+            erased = 0;
+
+            for (size_t i { 0 }; i < oldControl.size(); i++)
+            {
+                if (oldControl[i] >= 0)
+                    place(oldKeys[i], std::move(oldValues[i]));
+            }
+        }
+    };
+}
+)nubb" };
+
+    // GENERATOR functions are C++20 coroutines returning a Generator, which a FOR EACH loop steps through: the coroutine
+    // runs up to its next co_yield every time the loop wants a value, so nothing is stored but the current one.
+    // GCC never elides the coroutine frame's allocation, so the frame of a finished generator is kept for the next one
+    // of the same size instead, and a GENERATOR CALLed over and over in a loop doesn't allocate after the first time.
+    constexpr std::string_view generator { R"nubb(#include <coroutine>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <new>
+
+namespace nubb_gen
+{
+    template <typename T>
+    class Generator : public std::ranges::view_interface<Generator<T>>
+    {
+    public:
+        struct promise_type
+        {
+            T value {};
+
+            Generator get_return_object() { return Generator { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            template <typename Value>
+            std::suspend_always yield_value(Value&& next)
+            {
+                if constexpr (std::is_convertible_v<Value&&, T>)
+                    value = std::forward<Value>(next);
+                else // same elements, different allocator (--alloc-profile counts strings and arrays)
+                    value = T(std::ranges::begin(next), std::ranges::end(next));
+                return {};
+            }
+            void return_void() {}
+            void unhandled_exception() { throw; }
+
+            static void* operator new(size_t size)
+            {
+                Frame& spare { frame() };
+                if (spare.memory && spare.size == size)
+                    return std::exchange(spare.memory, nullptr);
+                return ::operator new(size);
+            }
+
+            static void operator delete(void* memory, size_t size)
+            {
+                Frame& spare { frame() };
+                if (spare.memory)
+                    ::operator delete(spare.memory);
+                spare = Frame { memory, size };
+            }
+        };
+
+        class Iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            std::coroutine_handle<promise_type> handle {};
+
+            const T& operator*() const { return handle.promise().value; }
+            Iterator& operator++()
+            {
+                handle.resume();
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+            friend bool operator==(const Iterator& it, std::default_sentinel_t) { return it.handle.done(); }
+        };
+
+        Generator() = default;
+        explicit Generator(std::coroutine_handle<promise_type> handle) : handle { handle } {}
+        Generator(Generator&& other) noexcept : handle { std::exchange(other.handle, {}) } {}
+        Generator& operator=(Generator&& other) noexcept
+        {
+            std::swap(handle, other.handle);
+            return *this;
+        }
+        ~Generator()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        // runs up to the first YIELD, so only one loop can go through a Generator
+        Iterator begin()
+        {
+            handle.resume();
+            return Iterator { handle };
+        }
+        std::default_sentinel_t end() const { return {}; }
+
+    private:
+        std::coroutine_handle<promise_type> handle {};
+
+        struct Frame
+        {
+            void* memory {};
+            size_t size {};
+        };
+
+        static Frame& frame()
+        {
+            thread_local struct Spare
+            {
+                Frame frame {};
+                ~Spare() { ::operator delete(frame.memory); }
+            } spare {};
+            return spare.frame;
+        }
+    };
+}
+)nubb" };
+
+    // matrix<type>: every element in one std::vector, row after row, so m:i:j is one multiply and add away and a loop
+    // along a row goes straight through memory. The kernels work in tiles small enough to stay in cache: transpose
+    // reads and writes a tile at a time, multiply reuses a tile of b for every row of a before moving on.
+    constexpr std::string_view matrix { R"nubb(#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace nubb_matrix
+{
+    [[noreturn, gnu::cold, gnu::noinline]] inline void fail(const char* message, long long first, long long second, int line)
+    {
+        nubb_io::out.flush();
+        std::fprintf(stderr, message, first, second, line);
+        std::exit(1);
+    }
+
+    template <typename T>
+    class Matrix
+    {
+    public:
+        constexpr Matrix() = default;
+        constexpr Matrix(int line, long long rows, long long cols)
+        {
+            if (rows < 0 || cols < 0)
+                fail("[FATAL] Matrix can't be %lld by %lld on line %d\n", rows, cols, line);
+            rowCount = static_cast<size_t>(rows);
+            colCount = static_cast<size_t>(cols);
+            values.resize(rowCount * colCount);
+        }
+
+        constexpr int rows() const { return static_cast<int>(rowCount); }
+        constexpr int cols() const { return static_cast<int>(colCount); }
+
+        constexpr T& operator()(size_t row, size_t col) { return values[row * colCount + col]; }
+        constexpr const T& operator()(size_t row, size_t col) const { return values[row * colCount + col]; }
+
+        // --bounds
+        constexpr T& at(long long row, long long col, int line)
+        {
+            check(row, col, line);
+            return (*this)(row, col);
+        }
+        constexpr const T& at(long long row, long long col, int line) const
+        {
+            check(row, col, line);
+            return (*this)(row, col);
+        }
+
+        constexpr T* row(size_t index) { return values.data() + index * colCount; }
+        constexpr const T* row(size_t index) const { return values.data() + index * colCount; }
+
+    private:
+        size_t rowCount { 0 };
+        size_t colCount { 0 };
+        std::vector<T> values {};
+
+        constexpr void check(long long row, long long col, int line) const
+        {
+            if (row < 0 || col < 0 || static_cast<size_t>(row) >= rowCount || static_cast<size_t>(col) >= colCount)
+                fail("[FATAL] Matrix index %lld:%lld is out of bounds on line %d\n", row, col, line);
+        }
+    };
+
+    inline constexpr size_t TILE { 64 }; // 64 * 64 doubles is 32KB, about an L1 cache
+
+    template <typename T>
+    constexpr Matrix<T> transpose(const Matrix<T>& m)
+    {
+        size_t rows { static_cast<size_t>(m.rows()) };
+        size_t cols { static_cast<size_t>(m.cols()) };
+        Matrix<T> out(0, cols, rows);
+        for (size_t i0 { 0 }; i0 < rows; i0 += TILE)
+        {
+            for (size_t j0 { 0 }; j0 < cols; j0 += TILE)
+            {
+                size_t iEnd { std::min(i0 + TILE, rows) };
+                size_t jEnd { std::min(j0 + TILE, cols) };
+                for (size_t i { i0 }; i < iEnd; i++)
+                {
+                    const T* in { m.row(i) };
+                    for (size_t j { j0 }; j < jEnd; j++)
+                    {
+                        out(j, i) = in[j];
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // out[j] += scale * in[j] for j < count. The pointers never overlap, and a whole tile has a count the compiler knows,
+    // which is what GCC needs at -O2 to vectorize it
+    template <typename T>
+    constexpr void scaleAdd(T* __restrict out, const T* __restrict in, T scale, size_t count)
+    {
+        if (count == TILE)
+        {
+            for (size_t j { 0 }; j < TILE; j++)
+            {
+                out[j] += scale * in[j];
+            }
+        }
+        else
+        {
+            for (size_t j { 0 }; j < count; j++)
+            {
+                out[j] += scale * in[j];
+            }
+        }
+    }
+
+    // a is n by k, b is k by m. Every row of a runs over a tile of b's rows, and the innermost loop goes along a row of b
+    // and the output at the same time
+    template <typename T>
+    constexpr Matrix<T> multiply(const Matrix<T>& a, const Matrix<T>& b, int line)
+    {
+        if (a.cols() != b.rows())
+            fail("[FATAL] Can't MULTIPLY a matrix with %lld columns by one with %lld rows on line %d\n", a.cols(), b.rows(), line);
+
+        size_t n { static_cast<size_t>(a.rows()) };
+        size_t k { static_cast<size_t>(a.cols()) };
+        size_t m { static_cast<size_t>(b.cols()) };
+        Matrix<T> out(line, n, m);
+        for (size_t k0 { 0 }; k0 < k; k0 += TILE)
+        {
+            size_t kEnd { std::min(k0 + TILE, k) };
+            for (size_t j0 { 0 }; j0 < m; j0 += TILE)
+            {
+                size_t jEnd { std::min(j0 + TILE, m) };
+                for (size_t i { 0 }; i < n; i++)
+                {
+                    const T* left { a.row(i) };
+                    for (size_t p { k0 }; p < kEnd; p++)
+                    {
+                        scaleAdd(out.row(i) + j0, b.row(p) + j0, left[p], jEnd - j0);
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // sum of every row, as an array
+    template <typename T>
+    constexpr std::vector<T> rowSums(const Matrix<T>& m)
+    {
+        std::vector<T> sums(static_cast<size_t>(m.rows()));
+        for (size_t i { 0 }; i < sums.size(); i++)
+        {
+            const T* in { m.row(i) };
+            T sum {};
+            for (size_t j { 0 }; j < static_cast<size_t>(m.cols()); j++)
+            {
+                sum += in[j];
+            }
+            sums[i] = sum;
+        }
+        return sums;
+    }
+
+    // sum of every column, adding whole rows on so memory is still read in order
+    template <typename T>
+    constexpr std::vector<T> colSums(const Matrix<T>& m)
+    {
+        std::vector<T> sums(static_cast<size_t>(m.cols()));
+        for (size_t i { 0 }; i < static_cast<size_t>(m.rows()); i++)
+        {
+            const T* in { m.row(i) };
+            for (size_t j { 0 }; j < sums.size(); j++)
+            {
+                sums[j] += in[j];
+            }
+        }
+        return sums;
+    }
+}
+)nubb" };
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <string>      // for std::string
+#include <string_view> // for std::string_view
+#include <vector>      // for std::vector
+#include <algorithm>   // std::sort
+
+// Set of names, used by the Parser for declared variables and labels.
+// std::set and std::unordered_set can't be used in constant expressions, so this is a small open addressing
+// hash set over std::vector, which can. Lookups and inserts stay O(1) on files with thousands of symbols.
+struct NameSet
+{
+    static constexpr unsigned char EMPTY { 0 };     // Slot never used
+    static constexpr unsigned char FULL { 1 };      // Slot holds a name
+    static constexpr unsigned char ERASED { 2 };    // Slot held a name, keeps probe chains going
+
+    std::vector<std::string> slots {};       // Names, indexed by hash
+    std::vector<unsigned char> states {};    // EMPTY, FULL or ERASED for every slot
+    size_t count { 0 };                      // Slots that are FULL
+    size_t used { 0 };                       // Slots that are FULL or ERASED
+
+    static constexpr size_t hash(std::string_view name);
+
+    constexpr size_t size() const { return count; }
+    constexpr size_t find(std::string_view name) const;
+    constexpr bool contains(std::string_view name) const;
+    constexpr void insert(std::string_view name);
+    constexpr void erase(std::string_view name);
+    constexpr void merge(const NameSet& other);
+    constexpr void grow();
+    constexpr std::vector<std::string> sorted() const;
+};
+
+// FNV-1a hash of name
+constexpr size_t NameSet::hash(std::string_view name)
+{
+    unsigned long long value { 14695981039346656037ull };
+
+    for (char c : name)
+    {
+        value ^= static_cast<unsigned char>(c);
+        value *= 1099511628211ull;
+    }
+    return static_cast<size_t>(value);
+}
+
+// Slot holding name, or slots.size() when name isn't in set
+constexpr size_t NameSet::find(std::string_view name) const
+{
+    if (count == 0)
+        return slots.size();
+
+    size_t mask { slots.size() - 1 };
+    for (size_t i { hash(name) & mask }; states[i] != EMPTY; i = (i + 1) & mask) // linear probing
+    {
+        if (states[i] == FULL && slots[i] == name)
+            return i;
+    }
+    return slots.size();
+}
+
+// Check if name is in set
+constexpr bool NameSet::contains(std::string_view name) const
+{
+    return find(name) != slots.size();
+}
+
+// Add name to set, does nothing if it's already there
+constexpr void NameSet::insert(std::string_view name)
+{
+    if (contains(name))
+        return;
+
+    if ((used + 1) * 2 > slots.size()) // keep at most half of the slots in use so probe chains stay short
+        grow();
+
+    size_t mask { slots.size() - 1 };
+    size_t i { hash(name) & mask };
+    while (states[i] == FULL)
+    {
+        i = (i + 1) & mask;
+    }
+
+    if (states[i] == EMPTY)
+        used++;
+
+    slots[i] = std::string(name);
+    states[i] = FULL;
+    count++;
+}
+
+// Remove name from set, does nothing if it isn't there
+constexpr void NameSet::erase(std::string_view name)
+{
+    size_t i { find(name) };
+    if (i == slots.size())
+        return;
+
+    slots[i].clear();
+    states[i] = ERASED;
+    count--;
+}
+
+// Add every name from another set
+constexpr void NameSet::merge(const NameSet& other)
+{
+    for (size_t i { 0 }; i < other.slots.size(); i++)
+    {
+        if (other.states[i] == FULL)
+            insert(other.slots[i]);
+    }
+}
+
+// Double the number of slots (at least 16) and re-insert every name, dropping ERASED slots
+constexpr void NameSet::grow()
+{
+    std::vector<std::string> oldSlots { std::move(slots) };
+    std::vector<unsigned char> oldStates { std::move(states) };
+
+    size_t capacity { 16 };
+    while (capacity < count * 4)
+    {
+        capacity *= 2;
+    }
+
+    slots = std::vector<std::string>(capacity);
+    states = std::vector<unsigned char>(capacity, EMPTY);
+    count = 0;
+    used = 0;
+
+    for (size_t i { 0 }; i < oldSlots.size(); i++)
+    {
+        if (oldStates[i] == FULL)
+            insert(oldSlots[i]);
+    }
+}
+
+// Every name in set in sorted order, for checks that should report problems in a predictable order
+constexpr std::vector<std::string> NameSet::sorted() const
+{
+    std::vector<std::string> names {};
+    names.reserve(count);
+
+    for (size_t i { 0 }; i < slots.size(); i++)
+    {
+        if (states[i] == FULL)
+            names.push_back(slots[i]);
+    }
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+#endif